@@ -0,0 +1,219 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#include <codi.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "kernels.hpp"
+
+/*
+ * Throughput benchmarks for the reverse tapes of CoDiPack.
+ *
+ * For every tape type and kernel the benchmark measures the recording, the reverse and forward evaluation and the
+ * reset of the tape. Each measurement is repeated and the fastest run is reported. The output is a semicolon
+ * separated csv table on std::cout with one row per tape type and kernel.
+ */
+
+/** @brief Number of repetitions for each measurement. */
+const int REPETITIONS = 3;
+
+/** @brief Size for the data of the unchecked tapes. Needs to be large enough for all kernels. */
+const size_t UNCHECKED_DATA_SIZE = 16 * 1024 * 1024;
+
+/** @brief Size for the statements of the unchecked tapes. Needs to be large enough for all kernels. */
+const size_t UNCHECKED_STMT_SIZE = 4 * 1024 * 1024;
+
+/**
+ * @brief Simple wall clock timer.
+ */
+struct Timer {
+  std::chrono::steady_clock::time_point startTime;
+
+  void start() {
+    startTime = std::chrono::steady_clock::now();
+  }
+
+  double stop() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  }
+};
+
+/**
+ * @brief Measured values for one tape and kernel.
+ */
+struct Result {
+  size_t statements;
+  double recordTime;
+  double reverseTime;
+  double forwardTime;
+  double resetTime;
+  double memoryUsed;
+  double memoryAllocated;
+
+  Result() :
+    statements(0),
+    recordTime(1e300),
+    reverseTime(1e300),
+    forwardTime(1e300),
+    resetTime(1e300),
+    memoryUsed(0.0),
+    memoryAllocated(0.0) {}
+};
+
+/*
+ * Preallocation of the unchecked tapes. Only the primal value tapes have a constant data vector.
+ */
+template<typename Tape>
+auto setConstantDataSize(Tape& tape, int) -> decltype(tape.setConstantDataSize(0), void()) {
+  tape.setConstantDataSize(UNCHECKED_DATA_SIZE);
+}
+
+template<typename Tape>
+void setConstantDataSize(Tape& tape, long) {
+  (void)tape;
+}
+
+template<typename Tape>
+void prepareTape(Tape& tape, bool unchecked) {
+  if(unchecked) {
+    tape.resize(UNCHECKED_DATA_SIZE, UNCHECKED_STMT_SIZE);
+    setConstantDataSize(tape, 0);
+  }
+}
+
+template<typename Real, typename Kernel>
+Result runKernel(bool unchecked) {
+  typename Real::TapeType& tape = Real::getGlobalTape();
+  prepareTape(tape, unchecked);
+
+  std::vector<Real> x(Kernel::inputs());
+  std::vector<Real> y(Kernel::outputs());
+
+  Result result;
+  Timer timer;
+  for(int rep = 0; rep < REPETITIONS; ++rep) {
+    for(size_t i = 0; i < x.size(); ++i) {
+      x[i] = 1.0 + 1e-3 * (double)(i % 1000);
+    }
+
+    timer.start();
+    tape.setActive();
+    for(size_t i = 0; i < x.size(); ++i) {
+      tape.registerInput(x[i]);
+    }
+    Kernel::eval(x, y);
+    for(size_t i = 0; i < y.size(); ++i) {
+      tape.registerOutput(y[i]);
+    }
+    tape.setPassive();
+    result.recordTime = std::min(result.recordTime, timer.stop());
+
+    result.statements = tape.getUsedStatementsSize();
+    codi::TapeValues values = tape.getTapeValues();
+    result.memoryUsed = values.getUsedMemorySize();
+    result.memoryAllocated = values.getAllocatedMemorySize();
+
+    for(size_t i = 0; i < y.size(); ++i) {
+      y[i].setGradient(1.0);
+    }
+    timer.start();
+    tape.evaluate();
+    result.reverseTime = std::min(result.reverseTime, timer.stop());
+    tape.clearAdjoints();
+
+    for(size_t i = 0; i < x.size(); ++i) {
+      x[i].setGradient(1.0);
+    }
+    timer.start();
+    tape.evaluateForward();
+    result.forwardTime = std::min(result.forwardTime, timer.stop());
+
+    timer.start();
+    tape.reset();
+    result.resetTime = std::min(result.resetTime, timer.stop());
+  }
+
+  return result;
+}
+
+void printHeader() {
+  std::cout << "tape; kernel; statements; record time [s]; record rate [stmt/s]; reverse time [s]; reverse rate [stmt/s]; "
+            << "forward time [s]; forward rate [stmt/s]; memory used [MB]; memory allocated [MB]; "
+            << "memory per statement [byte]; reset time [s]\n";
+}
+
+void printRow(const std::string& tapeName, const std::string& kernelName, const Result& r) {
+  double stmts = (double)r.statements;
+  double bytesPerStmt = 0.0;
+  if(0 != r.statements) {
+    bytesPerStmt = r.memoryUsed * 1024.0 * 1024.0 / stmts;
+  }
+
+  std::cout << tapeName << "; " << kernelName << "; " << r.statements
+            << "; " << r.recordTime << "; " << stmts / r.recordTime
+            << "; " << r.reverseTime << "; " << stmts / r.reverseTime
+            << "; " << r.forwardTime << "; " << stmts / r.forwardTime
+            << "; " << r.memoryUsed << "; " << r.memoryAllocated
+            << "; " << bytesPerStmt << "; " << r.resetTime << "\n";
+  std::cout.flush();
+}
+
+template<typename Real>
+void runTape(const std::string& tapeName, bool unchecked) {
+  printRow(tapeName, MatVecKernel::name(), runKernel<Real, MatVecKernel>(unchecked));
+  printRow(tapeName, StencilKernel::name(), runKernel<Real, StencilKernel>(unchecked));
+  printRow(tapeName, FluxKernel::name(), runKernel<Real, FluxKernel>(unchecked));
+  printRow(tapeName, ReductionKernel::name(), runKernel<Real, ReductionKernel>(unchecked));
+  printRow(tapeName, DeepExpressionKernel::name(), runKernel<Real, DeepExpressionKernel>(unchecked));
+}
+
+int main(int nargs, char** args) {
+  (void)nargs;
+  (void)args;
+
+  std::cout.precision(6);
+
+  printHeader();
+
+  runTape<codi::RealReverse>("RealReverse", false);
+  runTape<codi::RealReverseUnchecked>("RealReverseUnchecked", true);
+  runTape<codi::RealReverseIndex>("RealReverseIndex", false);
+  runTape<codi::RealReverseIndexUnchecked>("RealReverseIndexUnchecked", true);
+  runTape<codi::RealReversePrimal>("RealReversePrimal", false);
+  runTape<codi::RealReversePrimalUnchecked>("RealReversePrimalUnchecked", true);
+  runTape<codi::RealReversePrimalIndex>("RealReversePrimalIndex", false);
+  runTape<codi::RealReversePrimalIndexUnchecked>("RealReversePrimalIndexUnchecked", true);
+
+  return 0;
+}
@@ -0,0 +1,186 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/*
+ * Representative kernels for the benchmarks. Each kernel defines its name, the number of inputs and outputs and
+ * the function that computes the outputs from the inputs. The passive data of the kernels is generated on the fly
+ * such that the recording is dominated by the active computation.
+ */
+
+/**
+ * @brief Dense matrix vector product y = A x with a passive matrix.
+ */
+struct MatVecKernel {
+  static const char* name() { return "matVec"; }
+
+  static const size_t n = 1000;
+
+  static size_t inputs() { return n; }
+  static size_t outputs() { return n; }
+
+  template<typename Real>
+  static void eval(const std::vector<Real>& x, std::vector<Real>& y) {
+    for(size_t i = 0; i < n; ++i) {
+      Real sum = 0.0;
+      for(size_t j = 0; j < n; ++j) {
+        const double a = 1.0 / (1.0 + (double)((i + j) % 17));
+        sum += a * x[j];
+      }
+      y[i] = sum;
+    }
+  }
+};
+
+/**
+ * @brief Explicit time steps of the one dimensional heat equation with a three point stencil.
+ */
+struct StencilKernel {
+  static const char* name() { return "stencil"; }
+
+  static const size_t n = 100000;
+  static const size_t steps = 10;
+
+  static size_t inputs() { return n; }
+  static size_t outputs() { return n; }
+
+  template<typename Real>
+  static void eval(const std::vector<Real>& x, std::vector<Real>& y) {
+    std::vector<Real> u(x);
+    std::vector<Real> uNew(n);
+
+    for(size_t t = 0; t < steps; ++t) {
+      uNew[0] = u[0];
+      uNew[n - 1] = u[n - 1];
+      for(size_t i = 1; i < n - 1; ++i) {
+        uNew[i] = u[i] + 0.25 * (u[i - 1] - 2.0 * u[i] + u[i + 1]);
+      }
+      std::swap(u, uNew);
+    }
+
+    for(size_t i = 0; i < n; ++i) {
+      y[i] = u[i];
+    }
+  }
+};
+
+/**
+ * @brief Rusanov flux of the one dimensional Euler equations between neighbouring cells.
+ *
+ * The inputs are the conservative variables (rho, rho u, E) of all cells.
+ */
+struct FluxKernel {
+  static const char* name() { return "flux"; }
+
+  static const size_t cells = 50000;
+
+  static size_t inputs() { return 3 * cells; }
+  static size_t outputs() { return 3 * (cells - 1); }
+
+  template<typename Real>
+  static void eval(const std::vector<Real>& x, std::vector<Real>& y) {
+    using std::sqrt;
+    using std::abs;
+    using std::max;
+
+    const double gamma = 1.4;
+
+    for(size_t i = 0; i < cells - 1; ++i) {
+      const Real& rhoL = x[3 * i];
+      const Real& mL = x[3 * i + 1];
+      const Real& eL = x[3 * i + 2];
+      const Real& rhoR = x[3 * i + 3];
+      const Real& mR = x[3 * i + 4];
+      const Real& eR = x[3 * i + 5];
+
+      Real uL = mL / rhoL;
+      Real uR = mR / rhoR;
+      Real pL = (gamma - 1.0) * (eL - 0.5 * mL * uL);
+      Real pR = (gamma - 1.0) * (eR - 0.5 * mR * uR);
+      Real cL = sqrt(gamma * pL / rhoL);
+      Real cR = sqrt(gamma * pR / rhoR);
+      Real s = max(abs(uL) + cL, abs(uR) + cR);
+
+      y[3 * i] = 0.5 * (mL + mR) - 0.5 * s * (rhoR - rhoL);
+      y[3 * i + 1] = 0.5 * (mL * uL + pL + mR * uR + pR) - 0.5 * s * (mR - mL);
+      y[3 * i + 2] = 0.5 * ((eL + pL) * uL + (eR + pR) * uR) - 0.5 * s * (eR - eL);
+    }
+  }
+};
+
+/**
+ * @brief Long reduction with one statement per element.
+ */
+struct ReductionKernel {
+  static const char* name() { return "reduction"; }
+
+  static const size_t n = 1000000;
+
+  static size_t inputs() { return n; }
+  static size_t outputs() { return 1; }
+
+  template<typename Real>
+  static void eval(const std::vector<Real>& x, std::vector<Real>& y) {
+    Real sum = 0.0;
+    for(size_t i = 0; i < n; ++i) {
+      sum += x[i] * x[i];
+    }
+    y[0] = sum;
+  }
+};
+
+/**
+ * @brief Statements with deep expression trees and many arguments.
+ */
+struct DeepExpressionKernel {
+  static const char* name() { return "deepExpression"; }
+
+  static const size_t groups = 100000;
+
+  static size_t inputs() { return 8 * groups; }
+  static size_t outputs() { return groups; }
+
+  template<typename Real>
+  static void eval(const std::vector<Real>& x, std::vector<Real>& y) {
+    using std::sin;
+    using std::cos;
+    using std::exp;
+    using std::sqrt;
+
+    for(size_t i = 0; i < groups; ++i) {
+      const Real* v = &x[8 * i];
+      y[i] = ((v[0] * v[1] + sin(v[2])) / (v[3] + exp(v[4] * v[5])) - sqrt(v[6] * v[6] + v[7] * v[7]))
+           * cos(v[0] - v[7]) + (v[1] - v[2]) * (v[3] - v[4]) / (1.0 + v[5] * v[5] + v[6] * v[6]);
+    }
+  }
+};
@@ -42,12 +42,21 @@
 #include "codi/tapes/indices/reuseIndexHandlerUseCount.hpp"
 #include "codi/tapes/handles/staticFunctionHandleFactory.hpp"
 #include "codi/tapes/handles/staticObjectHandleFactory.hpp"
+#include "codi/tools/chainEliminationHelper.hpp"
 #include "codi/tools/dataStore.hpp"
 #include "codi/tools/derivativeHelper.hpp"
 #include "codi/tools/direction.hpp"
 #include "codi/tools/externalFunctionHelper.hpp"
+#include "codi/tools/fixedPointHelper.hpp"
+#include "codi/tools/levelScheduledEvaluator.hpp"
+#include "codi/tools/linearAlgebraHelper.hpp"
+#include "codi/tools/linearSolverHelper.hpp"
 #include "codi/tools/preaccumulationHelper.hpp"
 #include "codi/tools/statementPushHelper.hpp"
+#include "codi/tools/tapeGraph.hpp"
+#include "codi/tools/tapeLevelAnalysis.hpp"
+#include "codi/tools/tapeReorderHelper.hpp"
+#include "codi/tools/tapeValuesRecorder.hpp"
 #include "codi/tools/tapeVectorHelper.hpp"
 
 /**
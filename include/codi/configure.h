@@ -145,6 +145,86 @@ namespace codi {
   static size_t DefaultChunkSize = CODI_ChunkSize;
   #undef CODI_ChunkSize
 
+  #ifndef CODI_UseHugePages
+    #define CODI_UseHugePages false
+  #endif
+  /**
+   * @brief Allocate the chunks and the adjoint vector with huge page support.
+   *
+   * Large allocations are mapped with mmap and advised for transparent huge pages. This reduces the TLB misses
+   * in the evaluation of large tapes. See MemoryAllocation for details.
+   *
+   * It can be set with the preprocessor macro CODI_UseHugePages=<true/false>
+   */
+  const bool UseHugePages = CODI_UseHugePages;
+  #undef CODI_UseHugePages
+
+  #ifndef CODI_UseExplicitHugePages
+    #define CODI_UseExplicitHugePages false
+  #endif
+  /**
+   * @brief Try to use the reserved huge page pool of the system before transparent huge pages are used.
+   *
+   * Only used if UseHugePages is enabled.
+   *
+   * It can be set with the preprocessor macro CODI_UseExplicitHugePages=<true/false>
+   */
+  const bool UseExplicitHugePages = CODI_UseExplicitHugePages;
+  #undef CODI_UseExplicitHugePages
+
+  #ifndef CODI_HugePageSize
+    #define CODI_HugePageSize 2097152
+  #endif
+  /**
+   * @brief The size of a huge page in bytes. Mapped allocations are rounded up to a multiple of this size.
+   *
+   * It can be set with the preprocessor macro CODI_HugePageSize=<size>
+   */
+  const size_t HugePageSize = CODI_HugePageSize;
+  #undef CODI_HugePageSize
+
+  #ifndef CODI_HugePageThreshold
+    #define CODI_HugePageThreshold 2097152
+  #endif
+  /**
+   * @brief The minimum size in bytes of an allocation that is mapped with huge page support.
+   *
+   * Smaller allocations use the default allocation routines.
+   *
+   * It can be set with the preprocessor macro CODI_HugePageThreshold=<size>
+   */
+  const size_t HugePageThreshold = CODI_HugePageThreshold;
+  #undef CODI_HugePageThreshold
+
+  #ifndef CODI_NumaFirstTouch
+    #define CODI_NumaFirstTouch false
+  #endif
+  /**
+   * @brief Initialize new adjoint vector entries in an OpenMP parallel loop.
+   *
+   * The pages of the adjoint vector are then placed on the NUMA nodes of the threads that initialize them.
+   * Has no effect if the code is not compiled with OpenMP.
+   *
+   * It can be set with the preprocessor macro CODI_NumaFirstTouch=<true/false>
+   */
+  const bool NumaFirstTouch = CODI_NumaFirstTouch;
+  #undef CODI_NumaFirstTouch
+
+  #ifndef CODI_AdjointReserveSize
+    #define CODI_AdjointReserveSize 0
+  #endif
+  /**
+   * @brief Size of the address space in bytes that is reserved for the adjoint vector of the reverse tapes.
+   *
+   * If not zero, the adjoint vector is placed in a reservation of this size and grows by committing new pages. A
+   * resize then costs only the new pages and the address of the vector does not change. Only if the reservation is
+   * exhausted, the vector is moved to a reservation of twice the required size. Needs mmap support.
+   *
+   * It can be set with the preprocessor macro CODI_AdjointReserveSize=<size>
+   */
+  const size_t AdjointReserveSize = CODI_AdjointReserveSize;
+  #undef CODI_AdjointReserveSize
+
   #ifndef CODI_CheckExpressionArguments
     #define CODI_CheckExpressionArguments false
   #endif
@@ -263,6 +343,36 @@ namespace codi {
   const bool OptZeroAdjoint = CODI_OptZeroAdjoint;
   #undef CODI_OptZeroAdjoint
 
+  #ifndef CODI_ReversePrefetchDistance
+    #define CODI_ReversePrefetchDistance 0
+  #endif
+  /**
+   * @brief Prefetch distance for the reverse sweep of the Jacobian tapes.
+   *
+   * The reverse sweep walks the Jacobian and index data backwards and gathers the adjoint values
+   * at random positions. If the value is not zero, the adjoint entry and the Jacobian
+   * ReversePrefetchDistance entries ahead of the current argument are prefetched. A value of zero
+   * disables the prefetching.
+   *
+   * It can be set with the preprocessor macro CODI_ReversePrefetchDistance=<size>
+   */
+  const size_t ReversePrefetchDistance = CODI_ReversePrefetchDistance;
+  #undef CODI_ReversePrefetchDistance
+
+  #ifndef CODI_PreaccumulationVectorSize
+    #define CODI_PreaccumulationVectorSize 4
+  #endif
+  /**
+   * @brief Number of directions which are evaluated together in the local workspace of the preaccumulation.
+   *
+   * The local workspace preaccumulation evaluates the Jacobian of a code section in sweeps over a small vector
+   * workspace. Each sweep computes this many rows or columns of the Jacobian.
+   *
+   * It can be set with the preprocessor macro CODI_PreaccumulationVectorSize=<size>
+   */
+  const size_t PreaccumulationVectorSize = CODI_PreaccumulationVectorSize;
+  #undef CODI_PreaccumulationVectorSize
+
   #ifndef CODI_DisableAssignOptimization
     #define CODI_DisableAssignOptimization false
   #endif
@@ -333,7 +443,7 @@ namespace codi {
   /*
    * This switch enables a memory reduction technique for the Jacobian tapes. The arguments of each expression are
    * are searched for common identifiers. If one is found, then the Jacobians of the two arguments are summed together
-   * and only one argument instead of the two is stored.
+   * and only one argument instead of the two is stored. Expressions with only one active argument are not searched.
    *
    * It can be set with the preprocessor macro CODI_EnableCombineJacobianArguments=<1/0>
    */
@@ -493,6 +603,32 @@ namespace codi {
     void handleIndexFree(const Index& index);
   #endif
 
+  /*
+   * Enables the counters in the hot paths of the tapes, e.g. the number of chunk switches, adjoint vector resizes and
+   * the times for the recording and evaluation. See Instrumentation for details.
+   *
+   * If disabled, no code is generated for the instrumentation.
+   *
+   * It can be set with the preprocessor macro CODI_EnableInstrumentation=<true/false>
+   */
+  #ifndef CODI_EnableInstrumentation
+    #define CODI_EnableInstrumentation false
+  #endif
+
+  /*
+   * Enables the profiling of the reverse evaluation of the primal value tapes. The number of evaluations and the
+   * cycles are gathered for each statement handle, that is for each expression type. See StatementProfile for details.
+   *
+   * Every evaluated statement reads the cycle counter twice and performs a lookup in an unordered map. The option
+   * should therefore only be used for profiling runs. The profile is a global object that is not thread-safe, the
+   * tapes must not be evaluated in parallel if the option is enabled.
+   *
+   * It can be set with the preprocessor macro CODI_EnableStatementProfile=<true/false>
+   */
+  #ifndef CODI_EnableStatementProfile
+    #define CODI_EnableStatementProfile false
+  #endif
+
   #ifndef CODI_EnableAssert
     #define CODI_EnableAssert false
   #endif
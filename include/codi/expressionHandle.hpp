@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <typeinfo>
+
 #include "evaluateDefinitions.hpp"
 #include "tapeTypes.hpp"
 #include "typeTraits.hpp"
@@ -78,6 +80,11 @@ namespace codi {
        */
       const size_t maxConstantVariables;
 
+      /**
+       * @brief The mangled type name of the expression.
+       */
+      const char* const name;
+
       /**
        * @brief Creates the function handle object
        *
@@ -86,6 +93,7 @@ namespace codi {
        * @param[in]          tangentFunc  The function pointer for the tangent evaluation.
        * @param[in]   maxActiveVariables  The number of active variables in the statement.
        * @param[in] maxConstantVariables  The number of constant variables in the statement.
+       * @param[in]                 name  The mangled type name of the expression.
        *
        * @tparam  PrimalFunc  Function with the interface defined in EvaluateDefinitions<ReverseTapeTypes>::PrimalExprFunc
        * @tparam AdjointFunc  Function with the interface defined in EvaluateDefinitions<ReverseTapeTypes>::AdjointExprFunc
@@ -96,12 +104,14 @@ namespace codi {
                        const AdjointFunc adjointFunc,
                        const TangentFunc tangentFunc,
                        const size_t maxActiveVariables,
-                       const size_t maxConstantVariables) :
+                       const size_t maxConstantVariables,
+                       const char* name) :
         primalFunc(primalFunc),
         adjointFunc(adjointFunc),
         tangentFunc(tangentFunc),
         maxActiveVariables(maxActiveVariables),
-        maxConstantVariables(maxConstantVariables) {}
+        maxConstantVariables(maxConstantVariables),
+        name(name) {}
   };
 
 
@@ -146,5 +156,6 @@ namespace codi {
       Expr::template evalAdjoint<typename Tape::Index, typename Tape::GradientValue, 0, 0>,
       Expr::template evalTangent<typename Tape::Index, typename Tape::GradientValue, 0, 0>,
       ExpressionTraits<Expr>::maxActiveVariables,
-      ExpressionTraits<Expr>::maxConstantVariables);
+      ExpressionTraits<Expr>::maxConstantVariables,
+      typeid(Expr).name());
 }
@@ -110,6 +110,7 @@ namespace codi {
   CODI_DEFINE_BINARY_TRAIT(Divide)
   CODI_DEFINE_BINARY_TRAIT(Pow)
   CODI_DEFINE_BINARY_TRAIT(Atan2)
+  CODI_DEFINE_BINARY_TRAIT(Hypot)
   CODI_DEFINE_BINARY_TRAIT(Min)
   CODI_DEFINE_BINARY_TRAIT(Max)
   CODI_DEFINE_BINARY_TRAIT(Copysign)
@@ -131,9 +132,13 @@ namespace codi {
 
   CODI_DEFINE_UNARY_TRAIT(UnaryMinus)
   CODI_DEFINE_UNARY_TRAIT(Exp)
+  CODI_DEFINE_UNARY_TRAIT(Exp2)
+  CODI_DEFINE_UNARY_TRAIT(Expm1)
   CODI_DEFINE_UNARY_TRAIT(Tan)
   CODI_DEFINE_UNARY_TRAIT(Log)
   CODI_DEFINE_UNARY_TRAIT(Log10)
+  CODI_DEFINE_UNARY_TRAIT(Log2)
+  CODI_DEFINE_UNARY_TRAIT(Log1p)
   CODI_DEFINE_UNARY_TRAIT(Sqrt)
   CODI_DEFINE_UNARY_TRAIT(Cbrt)
   CODI_DEFINE_UNARY_TRAIT(Sin)
@@ -150,4 +155,39 @@ namespace codi {
   CODI_DEFINE_UNARY_TRAIT(Erf)
   CODI_DEFINE_UNARY_TRAIT(Erfc)
 # undef CODI_DEFINE_UNARY_TRAIT
+
+  /**
+   * @brief Specialization for the passive arguments of the fma expression.
+   *
+   * @tparam Real  The real type used in the active types.
+   */
+  template<typename Real>
+  struct ExpressionTraits<ConstantExpression<Real> > {
+    /** @brief A passive value has no active variables. */
+    static const size_t maxActiveVariables = 0;
+    /** @brief The passive value is stored as a constant. */
+    static const size_t maxConstantVariables = 1;
+  };
+
+  /**
+   * @brief Specialization for Fma.
+   *
+   * @tparam Real  The real type used in the active types.
+   * @tparam    A  The expression for the first factor.
+   * @tparam    B  The expression for the second factor.
+   * @tparam    C  The expression for the summand.
+   */
+  template<typename Real, typename A, typename B, typename C>
+  struct ExpressionTraits<Fma<Real, A, B, C> > {
+    /** @brief The sum of the active variables of the arguments. */
+    static const size_t maxActiveVariables =
+         ExpressionTraits<A>::maxActiveVariables
+       + ExpressionTraits<B>::maxActiveVariables
+       + ExpressionTraits<C>::maxActiveVariables;
+    /** @brief The sum of the constant variables of the arguments. */
+    static const size_t maxConstantVariables =
+         ExpressionTraits<A>::maxConstantVariables
+       + ExpressionTraits<B>::maxConstantVariables
+       + ExpressionTraits<C>::maxConstantVariables;
+  };
 }
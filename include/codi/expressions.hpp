@@ -39,6 +39,7 @@
 #include "configure.h"
 #include "exceptions.hpp"
 #include "macros.h"
+#include "mathBackend.hpp"
 #include "typeTraits.hpp"
 
 /**
@@ -509,6 +510,67 @@ namespace codi {
   #define PRIMAL_FUNCTION atan2
   #include "binaryExpression.tpp"
 
+  /*
+   * Implementation for f(a,b) = hypot(a,b)
+   */
+  /**
+   * @brief Helper function which computes the derivative of hypot with respect to one argument.
+   *
+   * The derivative is not defined at the point (0,0), zero is returned there.
+   *
+   * @param[in]      arg  The argument for which the derivative is computed.
+   * @param[in]   result  The result of hypot(a,b).
+   *
+   * @return The derivative arg / result.
+   *
+   * @tparam  Real  The real type used in the active types.
+   * @tparam   Arg  The type of the argument.
+   */
+  template<typename Real, typename Arg> CODI_INLINE Real derivativeHypot(const Arg& arg, const Real& result) {
+    if(result != 0.0) {
+      return arg / result;
+    } else {
+      return (Real)0.0;
+    }
+  }
+  template<typename Real, typename A, typename B> CODI_INLINE const Real gradientA_Hypot(const A& a, const B& b, const Real& result) {
+    CODI_UNUSED(b);
+    return derivativeHypot(a, result);
+  }
+  template<typename Real, typename A, typename B> CODI_INLINE const Real gradientB_Hypot(const A& a, const B& b, const Real& result) {
+    CODI_UNUSED(a);
+    return derivativeHypot(b, result);
+  }
+  template<typename Data, typename Real, typename A, typename B> CODI_INLINE void derv11_Hypot(Data& data, const A& a, const B& b, const Real& result) {
+    a.calcGradient(data, derivativeHypot(a.getValue(), result));
+    b.calcGradient(data, derivativeHypot(b.getValue(), result));
+  }
+  template<typename Data, typename Real, typename A, typename B> CODI_INLINE void derv11M_Hypot(Data& data, const A& a, const B& b, const Real& result, const Real& multiplier) {
+    a.calcGradient(data, multiplier * derivativeHypot(a.getValue(), result));
+    b.calcGradient(data, multiplier * derivativeHypot(b.getValue(), result));
+  }
+  template<typename Data, typename Real, typename A> CODI_INLINE void derv10_Hypot(Data& data, const A& a, const typename TypeTraits<Real>::PassiveReal& b, const Real& result) {
+    CODI_UNUSED(b);
+    a.calcGradient(data, derivativeHypot(a.getValue(), result));
+  }
+  template<typename Data, typename Real, typename A> CODI_INLINE void derv10M_Hypot(Data& data, const A& a, const typename TypeTraits<Real>::PassiveReal& b, const Real& result, const Real& multiplier) {
+    CODI_UNUSED(b);
+    a.calcGradient(data, multiplier * derivativeHypot(a.getValue(), result));
+  }
+  template<typename Data, typename Real, typename B> CODI_INLINE void derv01_Hypot(Data& data, const typename TypeTraits<Real>::PassiveReal& a, const B& b, const Real& result) {
+    CODI_UNUSED(a);
+    b.calcGradient(data, derivativeHypot(b.getValue(), result));
+  }
+  template<typename Data, typename Real, typename B> CODI_INLINE void derv01M_Hypot(Data& data, const typename TypeTraits<Real>::PassiveReal& a, const B& b, const Real& result, const Real& multiplier) {
+    CODI_UNUSED(a);
+    b.calcGradient(data, multiplier * derivativeHypot(b.getValue(), result));
+  }
+  using std::hypot;
+  #define NAME Hypot
+  #define FUNCTION hypot
+  #define PRIMAL_FUNCTION hypot
+  #include "binaryExpression.tpp"
+
   /*
    * Implementation for f(a,b) = pow(a,b)
    */
@@ -961,6 +1023,589 @@ namespace codi {
     return Max01<Real, B>(a, b.cast());
   }
 
+  /*
+   * Implementation of fma as an expression with three arguments
+   */
+
+  /**
+   * @brief Helper expression for a passive argument of an expression with more than two arguments.
+   *
+   * The value is handled like the passive arguments of the binary expressions. It is pushed as a constant value to
+   * the primal value tapes and does not provide any Jacobians.
+   *
+   * @tparam Real  The real type used in the active types.
+   */
+  template<typename Real>
+  struct ConstantExpression : public Expression<Real, ConstantExpression<Real> > {
+    private:
+      /** @brief The type for the passive values. */
+      typedef typename TypeTraits<Real>::PassiveReal PassiveReal;
+
+      /** @brief The passive value. */
+      const PassiveReal value_;
+
+    public:
+
+      /** @brief Because these are temporary objects they need to be stored as values. */
+      static const bool storeAsReference = false;
+
+      /**
+       * @brief Stores the passive value.
+       *
+       * @param[in] value  The passive value.
+       */
+      explicit ConstantExpression(const PassiveReal& value) :
+        value_(value) {}
+
+      /**
+       * @brief No Jacobi for a passive value.
+       *
+       * @param[in,out] data  Not used.
+       *
+       * @tparam Data The type for the tape data.
+       */
+      template<typename Data>
+      CODI_INLINE void calcGradient(Data& data) const {
+        CODI_UNUSED(data);
+      }
+
+      /**
+       * @brief No Jacobi for a passive value.
+       *
+       * @param[in,out]       data  Not used.
+       * @param[in]     multiplier  Not used.
+       *
+       * @tparam Data The type for the tape data.
+       */
+      template<typename Data>
+      CODI_INLINE void calcGradient(Data& data, const Real& multiplier) const {
+        CODI_UNUSED(data);
+        CODI_UNUSED(multiplier);
+      }
+
+      /**
+       * @brief No Jacobies for a passive value.
+       *
+       * @param[in,out] data  Not used.
+       *
+       * @tparam Data The type for the tape data.
+       */
+      template<typename Data>
+      CODI_INLINE void pushLazyJacobies(Data& data) const {
+        CODI_UNUSED(data);
+      }
+
+      /**
+       * @brief Return the passive value.
+       *
+       * @return The passive value.
+       */
+      CODI_INLINE const Real getValue() const {
+        return value_;
+      }
+
+      /**
+       * @brief Get the value from a static evaluation context.
+       *
+       * @param[in]        indices  Not used.
+       * @param[in] constantValues  The array of constant values in the expression.
+       * @param[in]   primalValues  Not used.
+       *
+       * @return The constant value at the offset.
+       *
+       * @tparam          Index  The type for the indices.
+       * @tparam         offset  The offset in the index array for the corresponding value.
+       * @tparam constantOffset  The offset for the constant values array
+       */
+      template<typename Index, size_t offset, size_t constantOffset>
+      static CODI_INLINE Real getValue(const Index* indices, const PassiveReal* constantValues, const Real* primalValues) {
+        CODI_UNUSED(indices);
+        CODI_UNUSED(primalValues);
+
+        return constantValues[constantOffset];
+      }
+
+      /**
+       * @brief No adjoint update for a passive value.
+       *
+       * @param[in]           seed  Not used.
+       * @param[in]        indices  Not used.
+       * @param[in] constantValues  Not used.
+       * @param[in]   primalValues  Not used.
+       * @param[in]  adjointValues  Not used.
+       *
+       * @tparam          Index  The type for the indices.
+       * @tparam  GradientValue  A type that supports add and scalar multiplication.
+       * @tparam         offset  The offset in the index array for the corresponding value.
+       * @tparam constantOffset  The offset for the constant values array
+       */
+      template<typename Index, typename GradientValue, size_t offset, size_t constantOffset>
+      static CODI_INLINE void evalAdjoint(const PRIMAL_SEED_TYPE& seed, const Index* indices, const PassiveReal* constantValues, const Real* primalValues, PRIMAL_ADJOINT_TYPE* adjointValues) {
+        CODI_UNUSED(seed);
+        CODI_UNUSED(indices);
+        CODI_UNUSED(constantValues);
+        CODI_UNUSED(primalValues);
+        CODI_UNUSED(adjointValues);
+      }
+
+      /**
+       * @brief No tangent update for a passive value.
+       *
+       * @param[in]           seed  Not used.
+       * @param[in,out] lhsAdjoint  Not used.
+       * @param[in]        indices  Not used.
+       * @param[in] constantValues  Not used.
+       * @param[in]   primalValues  Not used.
+       * @param[in]  adjointValues  Not used.
+       *
+       * @return The constant value.
+       *
+       * @tparam          Index  The type for the indices.
+       * @tparam  GradientValue  A type that supports add and scalar multiplication.
+       * @tparam         offset  The offset in the index array for the corresponding value.
+       * @tparam constantOffset  The offset for the constant values array
+       */
+      template<typename Index, typename GradientValue, size_t offset, size_t constantOffset>
+      static CODI_INLINE Real evalTangent(const Real& seed, GradientValue& lhsAdjoint, const Index* indices, const PassiveReal* constantValues, const Real* primalValues, PRIMAL_ADJOINT_TYPE* adjointValues) {
+        CODI_UNUSED(seed);
+        CODI_UNUSED(lhsAdjoint);
+        CODI_UNUSED(adjointValues);
+
+        return getValue<Index, offset, constantOffset>(indices, constantValues, primalValues);
+      }
+
+      /**
+       * @brief The passive value is handed to the action.
+       *
+       * @param[in,out] tape  The tape that calls the action.
+       * @param[in,out] data  The data that can be used by the action.
+       * @param[in]     func  The function that is called for every constant item.
+       *
+       * @tparam CallTape  The type of the tape that calls the action.
+       * @tparam     Data  The type of the data for the action.
+       * @tparam     Func  The type of the function that is called.
+       */
+      template<typename Tape, typename Data, typename Func>
+      CODI_INLINE void constantValueAction(Tape& tape, Data data, Func func) const {
+        CODI_CALL_MEMBER_FN(tape, func)(data, value_);
+      }
+
+      /**
+       * @brief No active values in the expression.
+       *
+       * @param[in,out] data  Not used.
+       * @param[in]     func  Not used.
+       *
+       * @tparam     Data  The type of the data for the action.
+       * @tparam     Func  The type of the function that is called.
+       */
+      template<typename Data, typename Func>
+      CODI_INLINE void valueAction(Data data, Func func) const {
+        CODI_UNUSED(data);
+        CODI_UNUSED(func);
+      }
+  };
+
+  /**
+   * @brief Primal function for fma.
+   *
+   * The call is forwarded to std::fma or to the fma overload of the CoDiPack types for higher order derivatives.
+   *
+   * @param[in] a  The first factor.
+   * @param[in] b  The second factor.
+   * @param[in] c  The summand.
+   *
+   * @return The rounded value of a * b + c.
+   *
+   * @tparam Real  The real type used in the active types.
+   */
+  template<typename Real> CODI_INLINE Real primal_fma(const Real& a, const Real& b, const Real& c) {
+    using std::fma;
+
+    return fma(a, b, c);
+  }
+
+  /**
+   * @brief Expression implementation for the fused multiply add a * b + c.
+   *
+   * The value is computed with a fused operation. The Jacobies are b, a and 1. Passive arguments are represented by
+   * a ConstantExpression.
+   *
+   * @tparam Real The real type used in the active types.
+   * @tparam    A The expression for the first factor.
+   * @tparam    B The expression for the second factor.
+   * @tparam    C The expression for the summand.
+   */
+  template<typename Real, class A, class B, class C>
+  struct Fma : public Expression<Real, Fma<Real, A, B, C> > {
+    private:
+
+      /** @brief The first factor. */
+      CODI_CREATE_STORE_TYPE(A) a_;
+
+      /** @brief The second factor. */
+      CODI_CREATE_STORE_TYPE(B) b_;
+
+      /** @brief The summand. */
+      CODI_CREATE_STORE_TYPE(C) c_;
+
+      /** @brief The offset of the second argument in the index array. */
+      static const size_t offsetB = ExpressionTraits<A>::maxActiveVariables;
+
+      /** @brief The offset of the second argument in the constant value array. */
+      static const size_t constantOffsetB = ExpressionTraits<A>::maxConstantVariables;
+
+      /** @brief The offset of the third argument in the index array. */
+      static const size_t offsetC = offsetB + ExpressionTraits<B>::maxActiveVariables;
+
+      /** @brief The offset of the third argument in the constant value array. */
+      static const size_t constantOffsetC = constantOffsetB + ExpressionTraits<B>::maxConstantVariables;
+
+    public:
+      /**
+       * @brief The passive type used in the origin.
+       *
+       * If Real is not an ActiveReal this value corresponds to Real,
+       * otherwise the PassiveValue from Real is used.
+       */
+      typedef typename TypeTraits<Real>::PassiveReal PassiveReal;
+
+      /** @brief Because these are temporary objects they need to be stored as values. */
+      static const bool storeAsReference = false;
+
+      /**
+       * @brief Stores the arguments of the expression.
+       *
+       * @param[in] a  The first factor.
+       * @param[in] b  The second factor.
+       * @param[in] c  The summand.
+       */
+      explicit Fma(const Expression<Real, A>& a, const Expression<Real, B>& b, const Expression<Real, C>& c) :
+        a_(a.cast()), b_(b.cast()), c_(c.cast()) {}
+
+      /**
+       * @brief Calculates the jacobies of the expression and hands them down to the arguments.
+       *
+       * @param[in,out] data A helper value which the tape can define and use for the evaluation.
+       *
+       * @tparam Data The type for the tape data.
+       */
+      template<typename Data>
+      CODI_INLINE void calcGradient(Data& data) const {
+        a_.calcGradient(data, b_.getValue());
+        b_.calcGradient(data, a_.getValue());
+        c_.calcGradient(data);
+      }
+
+      /**
+       * @brief Calculates the jacobies of the expression and hands them down to the arguments.
+       *
+       * @param[in,out]    data A helper value which the tape can define and use for the evaluation.
+       * @param[in]  multiplier The Jacobi from the expression where this expression was used as an argument.
+       *
+       * @tparam Data The type for the tape data.
+       */
+      template<typename Data>
+      CODI_INLINE void calcGradient(Data& data, const Real& multiplier) const {
+        a_.calcGradient(data, b_.getValue() * multiplier);
+        b_.calcGradient(data, a_.getValue() * multiplier);
+        c_.calcGradient(data, multiplier);
+      }
+
+      /**
+       * @brief The call is forwarded to the arguments.
+       *
+       * @param[in,out] data A helper value which the tape can define and use for the evaluation.
+       *
+       * @tparam Data The type for the tape data.
+       */
+      template<typename Data>
+      CODI_INLINE void pushLazyJacobies(Data& data) const {
+        a_.pushLazyJacobies(data);
+        b_.pushLazyJacobies(data);
+        c_.pushLazyJacobies(data);
+      }
+
+      /**
+       * @brief Return the numerical value of the expression.
+       *
+       * @return The value of the expression.
+       */
+      CODI_INLINE const Real getValue() const {
+        return primal_fma<Real>(a_.getValue(), b_.getValue(), c_.getValue());
+      }
+
+      /**
+       * @brief Get the value from a static evaluation context.
+       *
+       * @param[in]        indices  The indices for the values in the expressions.
+       * @param[in] constantValues  The array of constant values in the expression.
+       * @param[in]   primalValues  The global primal value vector.
+       *
+       * @return The corresponding primal value for the active real.
+       *
+       * @tparam          Index  The type for the indices.
+       * @tparam         offset  The offset in the index array for the corresponding value.
+       * @tparam constantOffset  The offset for the constant values array
+       */
+      template<typename Index, size_t offset, size_t constantOffset>
+      static CODI_INLINE Real getValue(const Index* indices, const PassiveReal* constantValues, const Real* primalValues) {
+        const Real aPrimal = A::template getValue<Index, offset, constantOffset>(indices, constantValues, primalValues);
+        const Real bPrimal = B::template getValue<Index, offset + offsetB, constantOffset + constantOffsetB>(indices, constantValues, primalValues);
+        const Real cPrimal = C::template getValue<Index, offset + offsetC, constantOffset + constantOffsetC>(indices, constantValues, primalValues);
+
+        return primal_fma<Real>(aPrimal, bPrimal, cPrimal);
+      }
+
+      /**
+       * @brief Calculate the gradient of the expression and update the seed. The updated seed is then
+       *        given to the argument expressions.
+       *
+       * @param[in]           seed  The seeding for the expression.
+       * @param[in]        indices  The indices for the values in the expressions.
+       * @param[in] constantValues  The array of constant values in the expression.
+       * @param[in]   primalValues  The global primal value vector.
+       * @param[in]  adjointValues  The global adjoint value vector.
+       *
+       * @tparam          Index  The type for the indices.
+       * @tparam  GradientValue  A type that supports add and scalar multiplication.
+       * @tparam         offset  The offset in the index array for the corresponding value.
+       * @tparam constantOffset  The offset for the constant values array
+       */
+      template<typename Index, typename GradientValue, size_t offset, size_t constantOffset>
+      static CODI_INLINE void evalAdjoint(const PRIMAL_SEED_TYPE& seed, const Index* indices, const PassiveReal* constantValues, const Real* primalValues, PRIMAL_ADJOINT_TYPE* adjointValues) {
+        const Real aPrimal = A::template getValue<Index, offset, constantOffset>(indices, constantValues, primalValues);
+        const Real bPrimal = B::template getValue<Index, offset + offsetB, constantOffset + constantOffsetB>(indices, constantValues, primalValues);
+
+        const PRIMAL_SEED_TYPE aJac = bPrimal * seed;
+        const PRIMAL_SEED_TYPE bJac = aPrimal * seed;
+        A::template evalAdjoint<Index, GradientValue, offset, constantOffset>(aJac, indices, constantValues, primalValues, adjointValues);
+        B::template evalAdjoint<Index, GradientValue, offset + offsetB, constantOffset + constantOffsetB>(bJac, indices, constantValues, primalValues, adjointValues);
+        C::template evalAdjoint<Index, GradientValue, offset + offsetC, constantOffset + constantOffsetC>(seed, indices, constantValues, primalValues, adjointValues);
+      }
+
+      /**
+       * @brief Calculate the tangent of the expression and update the seed. The updated seed is then
+       *        given to the argument expressions.
+       *
+       * @param[in]           seed  The seeding for the expression.
+       * @param[in,out] lhsAdjoint  The tangent value of the lhs side.
+       * @param[in]        indices  The indices for the values in the expressions.
+       * @param[in] constantValues  The array of constant values in the expression.
+       * @param[in]   primalValues  The global primal value vector.
+       * @param[in]  adjointValues  The global adjoint value vector.
+       *
+       * @return The primal value of the expression.
+       *
+       * @tparam          Index  The type for the indices.
+       * @tparam  GradientValue  A type that supports add and scalar multiplication.
+       * @tparam         offset  The offset in the index array for the corresponding value.
+       * @tparam constantOffset  The offset for the constant values array
+       */
+      template<typename Index, typename GradientValue, size_t offset, size_t constantOffset>
+      static CODI_INLINE Real evalTangent(const Real& seed, GradientValue& lhsAdjoint, const Index* indices, const PassiveReal* constantValues, const Real* primalValues, PRIMAL_ADJOINT_TYPE* adjointValues) {
+        const Real aPrimal = A::template getValue<Index, offset, constantOffset>(indices, constantValues, primalValues);
+        const Real bPrimal = B::template getValue<Index, offset + offsetB, constantOffset + constantOffsetB>(indices, constantValues, primalValues);
+
+        const Real aJac = bPrimal * seed;
+        const Real bJac = aPrimal * seed;
+        A::template evalTangent<Index, GradientValue, offset, constantOffset>(aJac, lhsAdjoint, indices, constantValues, primalValues, adjointValues);
+        B::template evalTangent<Index, GradientValue, offset + offsetB, constantOffset + constantOffsetB>(bJac, lhsAdjoint, indices, constantValues, primalValues, adjointValues);
+        const Real cPrimal = C::template evalTangent<Index, GradientValue, offset + offsetC, constantOffset + constantOffsetC>(seed, lhsAdjoint, indices, constantValues, primalValues, adjointValues);
+
+        return primal_fma<Real>(aPrimal, bPrimal, cPrimal);
+      }
+
+      /**
+       * @brief constantValueActions are called for every constant real in the expression.
+       *
+       * @param[in,out] tape  The tape that calls the action.
+       * @param[in,out] data  The data that can be used by the action.
+       * @param[in]     func  The function that is called for every constant item.
+       *
+       * @tparam CallTape  The type of the tape that calls the action.
+       * @tparam     Data  The type of the data for the action.
+       * @tparam     Func  The type of the function that is called.
+       */
+      template<typename Tape, typename Data, typename Func>
+      CODI_INLINE void constantValueAction(Tape& tape, Data data, Func func) const {
+        a_.constantValueAction(tape, data, func);
+        b_.constantValueAction(tape, data, func);
+        c_.constantValueAction(tape, data, func);
+      }
+
+      /**
+       * @brief The action is called on the tape for every active real.
+       *
+       * @param[in,out] data  The data that can be used by the action.
+       * @param[in]     func  The function that is called for every active real in the expression.
+       *
+       * @tparam     Data  The type of the data for the action.
+       * @tparam     Func  The type of the function that is called.
+       */
+      template<typename Data, typename Func>
+      CODI_INLINE void valueAction(Data data, Func func) const {
+        a_.valueAction(data, func);
+        b_.valueAction(data, func);
+        c_.valueAction(data, func);
+      }
+  };
+
+  /**
+   * @brief Specialization of the TypeTraits for the fma expression.
+   *
+   * @tparam Real  The floating point value of the active real.
+   * @tparam    A  The type of the first factor.
+   * @tparam    B  The type of the second factor.
+   * @tparam    C  The type of the summand.
+   */
+  template<typename RealType, typename A, typename B, typename C>
+  class TypeTraits< Fma<RealType, A, B, C> > {
+    public:
+      /**
+       * @brief The passive type is the passive type of Real.
+       */
+      typedef typename TypeTraits<RealType>::PassiveReal PassiveReal;
+
+      /**
+       * @brief The definition of the Real type for other classes.
+       */
+      typedef RealType Real;
+
+      /**
+       * @brief Get the primal value of the origin of this type.
+       * @param[in] t The value from which the primal is extracted.
+       * @return The primal value of the origin of this type..
+       */
+      static const typename TypeTraits<RealType>::PassiveReal getBaseValue(const Fma<RealType, A, B, C>& t) {
+        return TypeTraits<RealType>::getBaseValue(t.getValue());
+      }
+  };
+
+  /**
+   * @brief Overload for fma with the CoDiPack expressions.
+   *
+   * @param[in] a  The first factor.
+   * @param[in] b  The second factor.
+   * @param[in] c  The summand.
+   *
+   * @return The implementing expression Fma.
+   *
+   * @tparam Real  The real type used in the active types.
+   * @tparam    A  The expression for the first argument of the function
+   * @tparam    B  The expression for the second argument of the function
+   * @tparam    C  The expression for the third argument of the function
+   */
+  template <typename Real, class A, class B, class C>
+  CODI_INLINE Fma<Real, A, B, C> fma(const Expression<Real, A>& a, const Expression<Real, B>& b, const Expression<Real, C>& c) {
+    return Fma<Real, A, B, C>(a.cast(), b.cast(), c.cast());
+  }
+
+  /**
+   * @brief Overload for fma with the CoDiPack expressions.
+   *
+   * @param[in] a  The first factor.
+   * @param[in] b  The second factor.
+   * @param[in] c  The summand.
+   *
+   * @return The implementing expression Fma.
+   *
+   * @tparam Real  The real type used in the active types.
+   * @tparam    A  The expression for the first argument of the function
+   * @tparam    B  The expression for the second argument of the function
+   */
+  template <typename Real, class A, class B>
+  CODI_INLINE Fma<Real, A, B, ConstantExpression<Real> > fma(const Expression<Real, A>& a, const Expression<Real, B>& b, const typename TypeTraits<Real>::PassiveReal& c) {
+    return Fma<Real, A, B, ConstantExpression<Real> >(a.cast(), b.cast(), ConstantExpression<Real>(c));
+  }
+
+  /**
+   * @brief Overload for fma with the CoDiPack expressions.
+   *
+   * @param[in] a  The first factor.
+   * @param[in] b  The second factor.
+   * @param[in] c  The summand.
+   *
+   * @return The implementing expression Fma.
+   *
+   * @tparam Real  The real type used in the active types.
+   * @tparam    A  The expression for the first argument of the function
+   * @tparam    C  The expression for the third argument of the function
+   */
+  template <typename Real, class A, class C>
+  CODI_INLINE Fma<Real, A, ConstantExpression<Real>, C> fma(const Expression<Real, A>& a, const typename TypeTraits<Real>::PassiveReal& b, const Expression<Real, C>& c) {
+    return Fma<Real, A, ConstantExpression<Real>, C>(a.cast(), ConstantExpression<Real>(b), c.cast());
+  }
+
+  /**
+   * @brief Overload for fma with the CoDiPack expressions.
+   *
+   * @param[in] a  The first factor.
+   * @param[in] b  The second factor.
+   * @param[in] c  The summand.
+   *
+   * @return The implementing expression Fma.
+   *
+   * @tparam Real  The real type used in the active types.
+   * @tparam    B  The expression for the second argument of the function
+   * @tparam    C  The expression for the third argument of the function
+   */
+  template <typename Real, class B, class C>
+  CODI_INLINE Fma<Real, ConstantExpression<Real>, B, C> fma(const typename TypeTraits<Real>::PassiveReal& a, const Expression<Real, B>& b, const Expression<Real, C>& c) {
+    return Fma<Real, ConstantExpression<Real>, B, C>(ConstantExpression<Real>(a), b.cast(), c.cast());
+  }
+
+  /**
+   * @brief Overload for fma with the CoDiPack expressions.
+   *
+   * @param[in] a  The first factor.
+   * @param[in] b  The second factor.
+   * @param[in] c  The summand.
+   *
+   * @return The implementing expression Fma.
+   *
+   * @tparam Real  The real type used in the active types.
+   * @tparam    A  The expression for the first argument of the function
+   */
+  template <typename Real, class A>
+  CODI_INLINE Fma<Real, A, ConstantExpression<Real>, ConstantExpression<Real> > fma(const Expression<Real, A>& a, const typename TypeTraits<Real>::PassiveReal& b, const typename TypeTraits<Real>::PassiveReal& c) {
+    return Fma<Real, A, ConstantExpression<Real>, ConstantExpression<Real> >(a.cast(), ConstantExpression<Real>(b), ConstantExpression<Real>(c));
+  }
+
+  /**
+   * @brief Overload for fma with the CoDiPack expressions.
+   *
+   * @param[in] a  The first factor.
+   * @param[in] b  The second factor.
+   * @param[in] c  The summand.
+   *
+   * @return The implementing expression Fma.
+   *
+   * @tparam Real  The real type used in the active types.
+   * @tparam    B  The expression for the second argument of the function
+   */
+  template <typename Real, class B>
+  CODI_INLINE Fma<Real, ConstantExpression<Real>, B, ConstantExpression<Real> > fma(const typename TypeTraits<Real>::PassiveReal& a, const Expression<Real, B>& b, const typename TypeTraits<Real>::PassiveReal& c) {
+    return Fma<Real, ConstantExpression<Real>, B, ConstantExpression<Real> >(ConstantExpression<Real>(a), b.cast(), ConstantExpression<Real>(c));
+  }
+
+  /**
+   * @brief Overload for fma with the CoDiPack expressions.
+   *
+   * @param[in] a  The first factor.
+   * @param[in] b  The second factor.
+   * @param[in] c  The summand.
+   *
+   * @return The implementing expression Fma.
+   *
+   * @tparam Real  The real type used in the active types.
+   * @tparam    C  The expression for the third argument of the function
+   */
+  template <typename Real, class C>
+  CODI_INLINE Fma<Real, ConstantExpression<Real>, ConstantExpression<Real>, C> fma(const typename TypeTraits<Real>::PassiveReal& a, const typename TypeTraits<Real>::PassiveReal& b, const Expression<Real, C>& c) {
+    return Fma<Real, ConstantExpression<Real>, ConstantExpression<Real>, C>(ConstantExpression<Real>(a), ConstantExpression<Real>(b), c.cast());
+  }
+
 
   #undef CODI_OPERATOR_HELPER
 
@@ -1122,12 +1767,46 @@ namespace codi {
   #define PRIMAL_FUNCTION log10
   #include "unaryExpression.tpp"
 
+  template<typename Real> CODI_INLINE Real gradient_Log2(const Real& a, const Real& result) {
+    CODI_UNUSED(result);
+    if(CheckExpressionArguments) {
+      if(0.0 > TypeTraits<Real>::getBaseValue(a)) {
+        CODI_EXCEPTION("Logarithm of negative value or zero.(Value: %0.15e)", TypeTraits<Real>::getBaseValue(a));
+      }
+    }
+    return 1.442695040888963 / a; // log2'(a) = 1.0 / (a * log(2))
+  }
+  using std::log2;
+  #define NAME Log2
+  #define FUNCTION log2
+  #define PRIMAL_FUNCTION log2
+  #include "unaryExpression.tpp"
+
+  template<typename Real> CODI_INLINE Real gradient_Log1p(const Real& a, const Real& result) {
+    CODI_UNUSED(result);
+    if(CheckExpressionArguments) {
+      if(-1.0 > TypeTraits<Real>::getBaseValue(a)) {
+        CODI_EXCEPTION("Logarithm of value smaller than -1.(Value: %0.15e)", TypeTraits<Real>::getBaseValue(a));
+      }
+    }
+    return 1.0 / (1.0 + a);
+  }
+  using std::log1p;
+  #define NAME Log1p
+  #define FUNCTION log1p
+  #define PRIMAL_FUNCTION log1p
+  #include "unaryExpression.tpp"
+
   template<typename Real> CODI_INLINE Real gradient_Sin(const Real& a, const Real& result) {
     CODI_UNUSED(result);
     return cos(a);
   }
+  template<typename Real> CODI_INLINE void valueGradient_Sin(const Real& a, Real& result, Real& gradient) {
+    MathBackend::sincos(a, result, gradient);
+  }
   using std::sin;
   #define NAME Sin
+  #define VALUE_GRADIENT_FUNCTION valueGradient_Sin
   #define FUNCTION sin
   #define PRIMAL_FUNCTION sin
   #include "unaryExpression.tpp"
@@ -1136,8 +1815,13 @@ namespace codi {
     CODI_UNUSED(result);
     return -sin(a);
   }
+  template<typename Real> CODI_INLINE void valueGradient_Cos(const Real& a, Real& result, Real& gradient) {
+    MathBackend::sincos(a, gradient, result);
+    gradient = -gradient;
+  }
   using std::cos;
   #define NAME Cos
+  #define VALUE_GRADIENT_FUNCTION valueGradient_Cos
   #define FUNCTION cos
   #define PRIMAL_FUNCTION cos
   #include "unaryExpression.tpp"
@@ -1187,8 +1871,12 @@ namespace codi {
     CODI_UNUSED(result);
     return cosh(a);
   }
+  template<typename Real> CODI_INLINE void valueGradient_Sinh(const Real& a, Real& result, Real& gradient) {
+    MathBackend::sinhcosh(a, result, gradient);
+  }
   using std::sinh;
   #define NAME Sinh
+  #define VALUE_GRADIENT_FUNCTION valueGradient_Sinh
   #define FUNCTION sinh
   #define PRIMAL_FUNCTION sinh
   #include "unaryExpression.tpp"
@@ -1197,8 +1885,12 @@ namespace codi {
     CODI_UNUSED(result);
     return sinh(a);
   }
+  template<typename Real> CODI_INLINE void valueGradient_Cosh(const Real& a, Real& result, Real& gradient) {
+    MathBackend::sinhcosh(a, gradient, result);
+  }
   using std::cosh;
   #define NAME Cosh
+  #define VALUE_GRADIENT_FUNCTION valueGradient_Cosh
   #define FUNCTION cosh
   #define PRIMAL_FUNCTION cosh
   #include "unaryExpression.tpp"
@@ -1213,6 +1905,26 @@ namespace codi {
   #define PRIMAL_FUNCTION exp
   #include "unaryExpression.tpp"
 
+  template<typename Real> CODI_INLINE Real gradient_Exp2(const Real& a, const Real& result) {
+    CODI_UNUSED(a);
+    return 0.693147180559945 * result; // exp2'(a) = log(2) * exp2(a)
+  }
+  using std::exp2;
+  #define NAME Exp2
+  #define FUNCTION exp2
+  #define PRIMAL_FUNCTION exp2
+  #include "unaryExpression.tpp"
+
+  template<typename Real> CODI_INLINE Real gradient_Expm1(const Real& a, const Real& result) {
+    CODI_UNUSED(a);
+    return result + 1.0;
+  }
+  using std::expm1;
+  #define NAME Expm1
+  #define FUNCTION expm1
+  #define PRIMAL_FUNCTION expm1
+  #include "unaryExpression.tpp"
+
   template<typename Real> CODI_INLINE Real gradient_Atanh(const Real& a, const Real& result) {
     CODI_UNUSED(result);
     if(CheckExpressionArguments) {
@@ -1245,14 +1957,12 @@ namespace codi {
   #include "unaryExpression.tpp"
 
   template<typename Real> CODI_INLINE Real gradient_Tan(const Real& a, const Real& result) {
-    CODI_UNUSED(result);
     if(CheckExpressionArguments) {
       if(0.0 == cos(TypeTraits<Real>::getBaseValue(a))) {
         CODI_EXCEPTION("Tan evaluated at (0.5  + i) * PI.(Value: %0.15e)", TypeTraits<Real>::getBaseValue(a));
       }
     }
-    Real tmp = 1.0 / cos(a);
-    return tmp * tmp;
+    return 1.0 + result * result; // tan'(a) = 1 / cos(a)^2 = 1 + tan(a)^2
   }
   using std::tan ;
   #define NAME Tan
@@ -1422,4 +2132,20 @@ namespace codi {
     return ceil(a.getValue());
   }
 
+  using std::round;
+  /**
+   * @brief Overload for the round function with expressions.
+   *
+   * @param[in] a The argument of the function.
+   *
+   * @return The result of round on the primal value.
+   *
+   * @tparam Real The real type used in the active types.
+   * @tparam A The expression for the argument of the function
+   */
+  template<typename Real, class A>
+  CODI_INLINE typename codi::TypeTraits<Real>::PassiveReal round(const codi::Expression<Real, A>& a) {
+    return round(a.getValue());
+  }
+
 }
@@ -143,3 +143,17 @@
  */
 template<typename ...Args>
 void CODI_UNUSED_VAR(Args const & ... ) {}
+
+/**
+ * @brief Issue a software prefetch for the given address.
+ *
+ * On compilers without a prefetch intrinsic the macro expands to nothing.
+ *
+ * @param  ptr  The address that is prefetched.
+ * @param   rw  0 if the data will be read, 1 if the data will be written.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+  #define CODI_PREFETCH(ptr, rw) __builtin_prefetch((ptr), (rw), 1)
+#else
+  #define CODI_PREFETCH(ptr, rw) CODI_UNUSED(ptr)
+#endif
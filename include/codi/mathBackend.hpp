@@ -0,0 +1,101 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include "macros.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief The default math backend, it evaluates the kernels with the functions of the standard library.
+   *
+   * Some unary expressions need a second transcendental function of the same argument for the derivative, e.g.
+   * the derivative of sin is cos. If the value and the derivative are both required, which is the case in the
+   * tangent evaluation of the primal value tapes, they are computed with the combined kernels of the math backend.
+   *
+   * A different backend can be selected with the preprocessor macro CODI_MathBackend=<type>. The type needs to be
+   * declared before CoDiPack is included and has to provide the same static functions. This can be used to call
+   * e.g. the sincos function of a vector math library. The kernels are also instantiated with the CoDiPack types
+   * for higher order derivatives, a backend should forward these to this implementation.
+   */
+  struct StdMathBackend {
+
+      /**
+       * @brief Compute the sine and cosine of the argument.
+       *
+       * @param[in]            a  The argument.
+       * @param[out]   sineValue  The value of sin(a).
+       * @param[out] cosineValue  The value of cos(a).
+       *
+       * @tparam Real  The type of the argument.
+       */
+      template<typename Real>
+      static CODI_INLINE void sincos(const Real& a, Real& sineValue, Real& cosineValue) {
+        using std::sin;
+        using std::cos;
+
+        sineValue = sin(a);
+        cosineValue = cos(a);
+      }
+
+      /**
+       * @brief Compute the hyperbolic sine and cosine of the argument.
+       *
+       * @param[in]          a  The argument.
+       * @param[out] sinhValue  The value of sinh(a).
+       * @param[out] coshValue  The value of cosh(a).
+       *
+       * @tparam Real  The type of the argument.
+       */
+      template<typename Real>
+      static CODI_INLINE void sinhcosh(const Real& a, Real& sinhValue, Real& coshValue) {
+        using std::sinh;
+        using std::cosh;
+
+        sinhValue = sinh(a);
+        coshValue = cosh(a);
+      }
+  };
+
+  #ifndef CODI_MathBackend
+    #define CODI_MathBackend codi::StdMathBackend
+  #endif
+  /**
+   * @brief The math backend for the combined value and derivative kernels of the expressions.
+   *
+   * It can be set with the preprocessor macro CODI_MathBackend=<type>
+   */
+  typedef CODI_MathBackend MathBackend;
+  #undef CODI_MathBackend
+}
@@ -33,6 +33,7 @@
 
 #include "../configure.h"
 #include "../tools/io.hpp"
+#include "../tools/memoryAllocation.hpp"
 #include "../typeFunctions.hpp"
 
 /**
@@ -221,7 +222,7 @@ namespace codi {
      */
     void allocateData() {
       if(NULL == data) {
-        data = new Data[size];
+        data = MemoryAllocation::allocateArray<Data>(size);
       }
     }
 
@@ -230,7 +231,7 @@ namespace codi {
      */
     void deleteData() {
       if(NULL != data) {
-        delete [] data;
+        MemoryAllocation::freeArray(data, size);
         data = NULL;
       }
     }
@@ -343,11 +344,11 @@ namespace codi {
      */
     void allocateData() {
       if(NULL == data1) {
-        data1 = new Data1[size];
+        data1 = MemoryAllocation::allocateArray<Data1>(size);
       }
 
       if(NULL == data2) {
-        data2 = new Data2[size];
+        data2 = MemoryAllocation::allocateArray<Data2>(size);
       }
     }
 
@@ -356,12 +357,12 @@ namespace codi {
      */
     void deleteData() {
       if(NULL != data1) {
-        delete [] data1;
+        MemoryAllocation::freeArray(data1, size);
         data1 = NULL;
       }
 
       if(NULL != data2) {
-        delete [] data2;
+        MemoryAllocation::freeArray(data2, size);
         data2 = NULL;
       }
     }
@@ -487,15 +488,15 @@ namespace codi {
      */
     void allocateData() {
       if(NULL == data1) {
-        data1 = new Data1[size];
+        data1 = MemoryAllocation::allocateArray<Data1>(size);
       }
 
       if(NULL == data2) {
-        data2 = new Data2[size];
+        data2 = MemoryAllocation::allocateArray<Data2>(size);
       }
 
       if(NULL == data3) {
-        data3 = new Data3[size];
+        data3 = MemoryAllocation::allocateArray<Data3>(size);
       }
     }
 
@@ -504,17 +505,17 @@ namespace codi {
      */
     void deleteData() {
       if(NULL != data1) {
-        delete [] data1;
+        MemoryAllocation::freeArray(data1, size);
         data1 = NULL;
       }
 
       if(NULL != data2) {
-        delete [] data2;
+        MemoryAllocation::freeArray(data2, size);
         data2 = NULL;
       }
 
       if(NULL != data3) {
-        delete [] data3;
+        MemoryAllocation::freeArray(data3, size);
         data3 = NULL;
       }
     }
@@ -650,19 +651,19 @@ namespace codi {
      */
     void allocateData() {
       if(NULL == data1) {
-        data1 = new Data1[size];
+        data1 = MemoryAllocation::allocateArray<Data1>(size);
       }
 
       if(NULL == data2) {
-        data2 = new Data2[size];
+        data2 = MemoryAllocation::allocateArray<Data2>(size);
       }
 
       if(NULL == data3) {
-        data3 = new Data3[size];
+        data3 = MemoryAllocation::allocateArray<Data3>(size);
       }
 
       if(NULL == data4) {
-        data4 = new Data4[size];
+        data4 = MemoryAllocation::allocateArray<Data4>(size);
       }
     }
 
@@ -671,22 +672,22 @@ namespace codi {
      */
     void deleteData() {
       if(NULL != data1) {
-        delete [] data1;
+        MemoryAllocation::freeArray(data1, size);
         data1 = NULL;
       }
 
       if(NULL != data2) {
-        delete [] data2;
+        MemoryAllocation::freeArray(data2, size);
         data2 = NULL;
       }
 
       if(NULL != data3) {
-        delete [] data3;
+        MemoryAllocation::freeArray(data3, size);
         data3 = NULL;
       }
 
       if(NULL != data4) {
-        delete [] data4;
+        MemoryAllocation::freeArray(data4, size);
         data4 = NULL;
       }
     }
@@ -34,6 +34,7 @@
 #include "chunk.hpp"
 #include "emptyChunkVector.hpp"
 #include "pointerHandle.hpp"
+#include "../tools/instrumentation.hpp"
 
 /**
  * @brief Global namespace for CoDiPack - Code Differentiation Package
@@ -153,6 +154,10 @@ namespace codi {
 
     NestedVector* nested; /**< Pointer to the nested vector. */
 
+#if CODI_EnableInstrumentation
+    size_t chunkSwitches; /**< Number of calls to nextChunk. */
+#endif
+
   public:
 
     /**
@@ -167,6 +172,9 @@ namespace codi {
       curChunkIndex(0),
       chunkSize(chunkSize),
       nested(NULL)
+#if CODI_EnableInstrumentation
+      , chunkSwitches(0)
+#endif
     {
       setNested(nested);
     }
@@ -185,6 +193,9 @@ namespace codi {
       curChunkIndex(0),
       chunkSize(chunkSize),
       nested(NULL)
+#if CODI_EnableInstrumentation
+      , chunkSwitches(0)
+#endif
     {}
 
     /**
@@ -236,6 +247,9 @@ namespace codi {
       std::swap(positions, other.positions);
       std::swap(curChunkIndex, other.curChunkIndex);
       std::swap(chunkSize, other.chunkSize);
+#if CODI_EnableInstrumentation
+      std::swap(chunkSwitches, other.chunkSwitches);
+#endif
 
       curChunk = chunks[curChunkIndex];
       other.curChunk = other.chunks[other.curChunkIndex];
@@ -244,6 +258,26 @@ namespace codi {
 
     }
 
+#if CODI_EnableInstrumentation
+    /**
+     * @brief Add the counters of this vector and the nested vectors.
+     *
+     * @param[in,out] counters  The counters are added to this structure.
+     */
+    void addInstrumentation(Instrumentation& counters) const {
+      counters.chunkSwitches += chunkSwitches;
+      nested->addInstrumentation(counters);
+    }
+
+    /**
+     * @brief Set the counters of this vector and the nested vectors to zero.
+     */
+    void resetInstrumentation() {
+      chunkSwitches = 0;
+      nested->resetInstrumentation();
+    }
+#endif
+
     /**
      * @brief Sets the global chunk size and sets the size of all chunks.
      * @param chunkSize   The new chunk size.
@@ -281,6 +315,10 @@ namespace codi {
      * Always the position of the nested chunk vector is stored.
      */
     CODI_NO_INLINE void nextChunk() {
+#if CODI_EnableInstrumentation
+      chunkSwitches += 1;
+#endif
+
       curChunk->store();
 
       curChunkIndex += 1;
@@ -29,6 +29,7 @@
 #pragma once
 
 #include "../macros.h"
+#include "../tools/instrumentation.hpp"
 
 /**
  * @brief Global namespace for CoDiPack - Code Differentiation Package
@@ -77,6 +78,22 @@ namespace codi {
       //Do nothing
     }
 
+#if CODI_EnableInstrumentation
+    /**
+     * @brief No counters.
+     *
+     * @param[in,out] counters  Not used.
+     */
+    void addInstrumentation(Instrumentation& counters) const {
+      CODI_UNUSED(counters);
+    }
+
+    /**
+     * @brief No counters.
+     */
+    void resetInstrumentation() {}
+#endif
+
     /**
      * @brief Do nothing.
      */
@@ -34,6 +34,7 @@
 #include "../../evaluateDefinitions.hpp"
 #include "../../tapeTypes.hpp"
 #include "../../typeTraits.hpp"
+#include "../../tools/statementProfile.hpp"
 
 #include "handleFactoryInterface.hpp"
 
@@ -71,6 +72,10 @@ namespace codi {
     template<typename Expr, typename Tape>
     static CODI_INLINE Handle createHandle() {
 
+#if CODI_EnableStatementProfile
+      StatementProfile<Handle>::template registerHandle<Expr, Tape>(&Tape::template curryEvaluateHandle<Expr>);
+#endif
+
       return &Tape::template curryEvaluateHandle<Expr>;
     }
 
@@ -127,5 +132,18 @@ namespace codi {
       return typename Tape::Real();
     }
 
+
+    /**
+     * @brief Function handles do not provide the name of the expression.
+     *
+     * @param[in] handle  Unused
+     *
+     * @return Always NULL.
+     */
+    static CODI_INLINE const char* getHandleName(Handle handle) {
+      CODI_UNUSED(handle);
+
+      return NULL;
+    }
   };
 }
@@ -95,5 +95,14 @@ namespace codi {
      */
     template<typename Tape, typename ... Args>
     static CODI_INLINE void callForwardHandle(Handle handle, Args&& ... args);
+
+    /**
+     * @brief The name of the expression for which the handle was created.
+     *
+     * @param[in] handle  The handle the was generated by this factory.
+     *
+     * @return The mangled type name of the expression or NULL if the factory does not provide the information.
+     */
+    static CODI_INLINE const char* getHandleName(Handle handle);
   };
 }
@@ -28,11 +28,14 @@
 
 #pragma once
 
+#include <typeinfo>
+
 #include "../../configure.h"
 #include "../../evaluateDefinitions.hpp"
 #include "../../expressionHandle.hpp"
 #include "../../tapeTypes.hpp"
 #include "../../typeTraits.hpp"
+#include "../../tools/statementProfile.hpp"
 
 #include "handleFactoryInterface.hpp"
 
@@ -65,22 +68,29 @@ namespace codi {
        */
       const typename EvaluateDefinitions<ReverseTapeTypes>::TangentFunc tangentFunc;
 
+      /**
+       * @brief The mangled type name of the expression.
+       */
+      const char* const name;
+
       /**
        * @brief Populate the storae object.
        *
        * @param[in]  primalFunc  The function for the primal evaluation.
        * @param[in] adjointFunc  The function for the reverse evaluation.
        * @param[in] tangentFunc  The function for the tangent evaluation.
+       * @param[in]        name  The mangled type name of the expression.
        *
        * @tparam P  The type for the primal function object.
        * @tparam A  The type for the reverse function object.
        * @tparam T  The type for the tangent function object.
        */
       template<typename P, typename A, typename T>
-      FunctionHandle(const P primalFunc, const A adjointFunc, const T tangentFunc) :
+      FunctionHandle(const P primalFunc, const A adjointFunc, const T tangentFunc, const char* name) :
         primalFunc(primalFunc),
         adjointFunc(adjointFunc),
-        tangentFunc(tangentFunc) {}
+        tangentFunc(tangentFunc),
+        name(name) {}
   };
 
 
@@ -121,7 +131,8 @@ namespace codi {
     FunctionStore<Tape, Expr>::handle(
       &Tape::template curryEvaluatePrimalHandle<Expr>,
       &Tape::template curryEvaluateHandle<Expr>,
-      &Tape::template curryEvaluateForwardHandle<Expr>);
+      &Tape::template curryEvaluateForwardHandle<Expr>,
+      typeid(Expr).name());
 
   /**
    * @brief A factory for function handles, that use static objects to store the data for the function call.
@@ -149,6 +160,10 @@ namespace codi {
       template<typename Expr, typename Tape>
       static CODI_INLINE Handle createHandle() {
 
+#if CODI_EnableStatementProfile
+        StatementProfile<Handle>::template registerHandle<Expr, Tape>(FunctionStore<Tape, Expr>::getHandle());
+#endif
+
         return FunctionStore<Tape, Expr>::getHandle();
       }
 
@@ -199,5 +214,16 @@ namespace codi {
 
         return handle->tangentFunc(std::forward<Args>(args)...);
       }
+
+      /**
+       * @brief The name of the expression for which the handle was created.
+       *
+       * @param[in] handle  The handle the was generated by this factory.
+       *
+       * @return The mangled type name of the expression.
+       */
+      static CODI_INLINE const char* getHandleName(Handle handle) {
+        return handle->name;
+      }
   };
 }
@@ -31,6 +31,7 @@
 #include "../../configure.h"
 #include "../../expressionHandle.hpp"
 #include "../../typeTraits.hpp"
+#include "../../tools/statementProfile.hpp"
 
 #include "handleFactoryInterface.hpp"
 
@@ -69,6 +70,10 @@ namespace codi {
       template<typename Expr, typename Tape>
       static CODI_INLINE Handle createHandle() {
 
+#if CODI_EnableStatementProfile
+        StatementProfile<Handle>::template registerHandle<Expr, Tape>(ExpressionStore<Tape, Expr>::getHandle());
+#endif
+
         return ExpressionStore<Tape, Expr>::getHandle();
       }
 
@@ -130,5 +135,16 @@ namespace codi {
                                            handle->maxConstantVariables,
                                            std::forward<Args>(args)...);
       }
+
+      /**
+       * @brief The name of the expression for which the handle was created.
+       *
+       * @param[in] handle  The handle the was generated by this factory.
+       *
+       * @return The mangled type name of the expression.
+       */
+      static CODI_INLINE const char* getHandleName(Handle handle) {
+        return handle->name;
+      }
   };
 }
@@ -32,6 +32,7 @@
 
 #include "../../configure.h"
 #include "../../macros.h"
+#include "../../tools/instrumentation.hpp"
 #include "../../tools/tapeValues.hpp"
 
 /**
@@ -214,6 +215,22 @@ namespace codi {
         // Do nothing
       }
 
+#if CODI_EnableInstrumentation
+      /**
+       * @brief There are no counters for this handler.
+       *
+       * @param[in,out] counters  Not used.
+       */
+      void addInstrumentation(Instrumentation& counters) const {
+        CODI_UNUSED(counters);
+      }
+
+      /**
+       * @brief There are no counters for this handler.
+       */
+      void resetInstrumentation() {}
+#endif
+
     /**
      * @brief There are no chunks, that need to be iterated.
      *
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "../../configure.h"
+#include "../../tools/instrumentation.hpp"
 #include "../../tools/tapeValues.hpp"
 
 /**
@@ -108,6 +109,11 @@ namespace codi {
        */
       bool valid;
 
+#if CODI_EnableInstrumentation
+      size_t indexReuseHits;   /**< Number of created indices that were used before. */
+      size_t indexReuseMisses; /**< Number of created indices that were not used before. */
+#endif
+
     public:
 
       /**
@@ -126,6 +132,10 @@ namespace codi {
         unusedIndicesPos(0),
         indexSizeIncrement(DefaultSmallChunkSize),
         valid(true)
+#if CODI_EnableInstrumentation
+        , indexReuseHits(0)
+        , indexReuseMisses(0)
+#endif
       {
         increaseIndicesSize(unusedIndices);
         generateNewIndices();
@@ -176,9 +186,15 @@ namespace codi {
 
           unusedIndicesPos -= 1;
           index = unusedIndices[unusedIndicesPos];
+#if CODI_EnableInstrumentation
+          indexReuseMisses += 1;
+#endif
         } else {
           usedIndicesPos -= 1;
           index = usedIndices[usedIndicesPos];
+#if CODI_EnableInstrumentation
+          indexReuseHits += 1;
+#endif
         }
 
 #if CODI_IndexHandle
@@ -202,6 +218,9 @@ namespace codi {
 
         unusedIndicesPos -= 1;
         index = unusedIndices[unusedIndicesPos];
+#if CODI_EnableInstrumentation
+        indexReuseMisses += 1;
+#endif
 
 #if CODI_IndexHandle
         handleIndexCreate(index);
@@ -329,6 +348,26 @@ namespace codi {
         values.addData("Memory allocated", memoryAllocatedIndices, false, true);
       }
 
+#if CODI_EnableInstrumentation
+      /**
+       * @brief Add the counters for the index reuse.
+       *
+       * @param[in,out] counters  The counters are added to this structure.
+       */
+      void addInstrumentation(Instrumentation& counters) const {
+        counters.indexReuseHits += indexReuseHits;
+        counters.indexReuseMisses += indexReuseMisses;
+      }
+
+      /**
+       * @brief Set the counters for the index reuse to zero.
+       */
+      void resetInstrumentation() {
+        indexReuseHits = 0;
+        indexReuseMisses = 0;
+      }
+#endif
+
     private:
       CODI_NO_INLINE void generateNewIndices() {
         // method is only called when unused indices are empty
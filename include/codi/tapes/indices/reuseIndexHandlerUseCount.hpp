@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "../../configure.h"
+#include "../../tools/instrumentation.hpp"
 #include "../../tools/tapeValues.hpp"
 
 /**
@@ -117,6 +118,11 @@ namespace codi {
        */
       bool valid;
 
+#if CODI_EnableInstrumentation
+      size_t indexReuseHits;   /**< Number of created indices that were used before. */
+      size_t indexReuseMisses; /**< Number of created indices that were not used before. */
+#endif
+
     public:
 
       /**
@@ -136,6 +142,10 @@ namespace codi {
         indexUse(DefaultSmallChunkSize),
         indexSizeIncrement(DefaultSmallChunkSize),
         valid(true)
+#if CODI_EnableInstrumentation
+        , indexReuseHits(0)
+        , indexReuseMisses(0)
+#endif
       {
         increaseIndicesSize(unusedIndices);
         generateNewIndices();
@@ -191,9 +201,15 @@ namespace codi {
 
           unusedIndicesPos -= 1;
           index = unusedIndices[unusedIndicesPos];
+#if CODI_EnableInstrumentation
+          indexReuseMisses += 1;
+#endif
         } else {
           usedIndicesPos -= 1;
           index = usedIndices[usedIndicesPos];
+#if CODI_EnableInstrumentation
+          indexReuseHits += 1;
+#endif
         }
 
 #if CODI_IndexHandle
@@ -219,6 +235,9 @@ namespace codi {
 
         unusedIndicesPos -= 1;
         index = unusedIndices[unusedIndicesPos];
+#if CODI_EnableInstrumentation
+        indexReuseMisses += 1;
+#endif
 
 #if CODI_IndexHandle
         handleIndexCreate(index);
@@ -372,6 +391,26 @@ namespace codi {
         values.addData("Memory index use vec", memoryIndexUse, true, true);
       }
 
+#if CODI_EnableInstrumentation
+      /**
+       * @brief Add the counters for the index reuse.
+       *
+       * @param[in,out] counters  The counters are added to this structure.
+       */
+      void addInstrumentation(Instrumentation& counters) const {
+        counters.indexReuseHits += indexReuseHits;
+        counters.indexReuseMisses += indexReuseMisses;
+      }
+
+      /**
+       * @brief Set the counters for the index reuse to zero.
+       */
+      void resetInstrumentation() {
+        indexReuseHits = 0;
+        indexReuseMisses = 0;
+      }
+#endif
+
     private:
 
       CODI_NO_INLINE void generateNewIndices() {
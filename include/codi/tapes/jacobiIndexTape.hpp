@@ -28,8 +28,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <tuple>
 
@@ -131,6 +133,7 @@ namespace codi {
 
     friend TapeBaseModule<TapeTypes, JacobiIndexTape>; /**< No doc */
     friend StatementModule<TapeTypes, JacobiIndexTape>;  /**< No doc */
+    friend ExternalFunctionModule<TapeTypes, JacobiIndexTape>;  /**< No doc */
     friend ::codi::IOModule<TapeTypes, JacobiIndexTape>;  /**< No doc */
 
     CODI_INLINE_REVERSE_TAPE_TYPES(TapeTypes::BaseTypes)
@@ -318,6 +321,8 @@ namespace codi {
      * It has to hold startAdjPos >= endAdjPos.
      *
      * @param[in,out]      adjointData  The vector of the adjoint variables.
+     * @param[in,out]         minIndex  The smallest index of the arguments is added.
+     * @param[in,out]         maxIndex  The largest index of the arguments is added.
      * @param[in,out]          dataPos The current position in the jacobi and index vector. This value is used in the next invocation of this method..
      * @param[in]           endDataPos The end position in the jacobi and index vector.
      * @param[in]             jacobies The pointer to the jacobies of the rhs arguments.
@@ -330,7 +335,7 @@ namespace codi {
      * @tparam AdjointData The data for the adjoint vector it needs to support add, multiply and comparison operations.
      */
     template<typename AdjointData>
-    static CODI_INLINE void evaluateStackReverse(AdjointData* adjointData,
+    static CODI_INLINE void evaluateStackReverse(AdjointData* adjointData, Index& minIndex, Index& maxIndex,
                                           size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
                                           size_t& stmtPos, const size_t& endStmtPos, StatementInt* &numberOfArguments,
                                           Index* lhsIndices) {
@@ -348,6 +353,13 @@ namespace codi {
 #endif
 
         JacobiModule<TapeTypes, JacobiIndexTape>::incrementAdjoints(adj, adjointData, numberOfArguments[stmtPos], dataPos, jacobies, indices);
+
+        // The arguments are now at the current data position.
+        const size_t endArgPos = dataPos + (size_t)numberOfArguments[stmtPos];
+        for(size_t curArg = dataPos; curArg < endArgPos; ++curArg) {
+          minIndex = std::min(minIndex, indices[curArg]);
+          maxIndex = std::max(maxIndex, indices[curArg]);
+        }
       }
     }
 
@@ -367,12 +379,17 @@ namespace codi {
     template<typename AdjointData>
     CODI_INLINE void evaluateInternal(const Position& start, const Position& end, AdjointData* adjointData) {
 
+      Index minIndex = std::numeric_limits<Index>::max();
+      Index maxIndex = Index();
+
       Wrap_evaluateStackReverse<AdjointData> evalFunc{};
-      auto reverseFunc = &TapeTypes::JacobiVector::template evaluateReverse<decltype(evalFunc), AdjointData*&>;
+      auto reverseFunc = &TapeTypes::JacobiVector::template evaluateReverse<decltype(evalFunc), AdjointData*&, Index&, Index&>;
 
       AdjointInterfaceImpl<Real, Index, AdjointData> interface(adjointData);
 
-      this->evaluateExtFunc(start, end, reverseFunc, this->jacobiVector, &interface, evalFunc, adjointData);
+      this->evaluateExtFunc(start, end, reverseFunc, this->jacobiVector, &interface, evalFunc, adjointData, minIndex, maxIndex);
+
+      this->setSweepAdjoints(start.chunk != end.chunk || start.data != end.data, minIndex, maxIndex);
     }
 
     /**
@@ -381,6 +398,8 @@ namespace codi {
      * It has to hold startAdjPos <= endAdjPos.
      *
      * @param[in,out]      adjointData  The vector of the adjoint variables.
+     * @param[in,out]         minIndex  The smallest index of the lhs values is added.
+     * @param[in,out]         maxIndex  The largest index of the lhs values is added.
      * @param[in,out]          dataPos The current position in the jacobi and index vector. This value is used in the next invocation of this method..
      * @param[in]           endDataPos The end position in the jacobi and index vector.
      * @param[in]             jacobies The pointer to the jacobies of the rhs arguments.
@@ -393,7 +412,7 @@ namespace codi {
      * @tparam AdjointData The data for the adjoint vector it needs to support add, multiply and comparison operations.
      */
     template<typename AdjointData>
-    static CODI_INLINE void evaluateStackForward(AdjointData* adjointData,
+    static CODI_INLINE void evaluateStackForward(AdjointData* adjointData, Index& minIndex, Index& maxIndex,
                                           size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
                                           size_t& stmtPos, const size_t& endStmtPos, StatementInt* &numberOfArguments,
                                           Index* lhsIndices) {
@@ -405,6 +424,8 @@ namespace codi {
 
         JacobiModule<TapeTypes, JacobiIndexTape>::incrementTangents(adj, adjointData, numberOfArguments[stmtPos], dataPos, jacobies, indices);
         adjointData[lhsIndex] = adj;
+        minIndex = std::min(minIndex, lhsIndex);
+        maxIndex = std::max(maxIndex, lhsIndex);
 
         ++stmtPos;
       }
@@ -412,6 +433,41 @@ namespace codi {
 
     WRAP_FUNCTION_TEMPLATE(Wrap_evaluateStackForward, evaluateStackForward);
 
+    /**
+     * @brief Call the function object for each statement in the stack.
+     *
+     * It has to hold startAdjPos <= endAdjPos.
+     *
+     * @param[in,out]             func The function object that is called for each statement.
+     * @param[in,out]          dataPos The current position in the jacobi and index vector. This value is used in the next invocation of this method..
+     * @param[in]           endDataPos The end position in the jacobi and index vector.
+     * @param[in]             jacobies The pointer to the jacobies of the rhs arguments.
+     * @param[in]              indices The pointer the indices of the rhs arguments.
+     * @param[in,out]          stmtPos The starting point in the expression evaluation. The index is incremented.
+     * @param[in]           endStmtPos The ending point in the expression evaluation.
+     * @param[in]    numberOfArguments The pointer to the number of arguments of the statement.
+     * @param[in]           lhsIndices The pointer the indices of the lhs.
+     *
+     * @tparam Func  See forEachStatement for the signature.
+     */
+    template<typename Func>
+    static CODI_INLINE void iterateStackForward(Func& func,
+                                         size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
+                                         size_t& stmtPos, const size_t& endStmtPos, StatementInt* &numberOfArguments,
+                                         Index* lhsIndices) {
+      CODI_UNUSED(endDataPos);
+
+      while(stmtPos < endStmtPos) {
+        const size_t nArgs = numberOfArguments[stmtPos];
+        func(lhsIndices[stmtPos], nArgs, &indices[dataPos], &jacobies[dataPos], (const char*)NULL);
+        dataPos += nArgs;
+
+        ++stmtPos;
+      }
+    }
+
+    WRAP_FUNCTION_TEMPLATE(Wrap_iterateStackForward, iterateStackForward);
+
     /**
      * @brief Evaluate the stack in forward order.
      *
@@ -426,12 +482,17 @@ namespace codi {
     template<typename AdjointData>
     CODI_INLINE void evaluateForwardInternal(const Position& start, const Position& end, AdjointData* adjointData) {
 
+      Index minIndex = std::numeric_limits<Index>::max();
+      Index maxIndex = Index();
+
       Wrap_evaluateStackForward<AdjointData> evalFunc{};
-      auto forwardFunc = &TapeTypes::JacobiVector::template evaluateForward<decltype(evalFunc), AdjointData*&>;
+      auto forwardFunc = &TapeTypes::JacobiVector::template evaluateForward<decltype(evalFunc), AdjointData*&, Index&, Index&>;
 
       AdjointInterfaceImpl<Real, Index, AdjointData> interface(adjointData);
 
-      this->evaluateExtFuncForward(start, end, forwardFunc, this->jacobiVector, &interface, evalFunc, adjointData);
+      this->evaluateExtFuncForward(start, end, forwardFunc, this->jacobiVector, &interface, evalFunc, adjointData, minIndex, maxIndex);
+
+      this->setSweepAdjoints(start.chunk != end.chunk || start.data != end.data, minIndex, maxIndex);
     }
 
   public:
@@ -446,6 +507,18 @@ namespace codi {
       indexHandler.assignUnusedIndex(value.getGradientData());
     }
 
+    /**
+     * @brief Register an input variable whose index is managed by the caller.
+     *
+     * Same as registerInput for an index that does not belong to an active type, e.g. if statements are recorded with
+     * storeManual and pushJacobiManual on a tape that is not the global one.
+     *
+     * @param[out] index  Is assigned a non zero value.
+     */
+    CODI_INLINE void registerManualInput(Index& index) {
+      indexHandler.assignUnusedIndex(index);
+    }
+
     /**
      * @brief Modify the output of an external function such that the tape sees it as an active variable.
      *
@@ -469,6 +542,45 @@ namespace codi {
       }
     }
 
+    /**
+     * @brief Call the function object for each statement between the start and the end position.
+     *
+     * The statements are visited in the order of the recording. The function object is called as
+     * \code{.cpp}
+     *   func(lhsIndex, nArgs, indices, jacobies, operation);
+     * \endcode
+     * with the types (const Index&, size_t, const Index*, const Real*, const char*). The Jacobians are the stored values of the tape and operation is always NULL.
+     *
+     * Input statements and external functions are skipped.
+     *
+     * It has to hold start <= end.
+     *
+     * @param[in]  start  The starting position.
+     * @param[in]    end  The ending position.
+     * @param[in,out] func  The function object that is called for each statement.
+     *
+     * @tparam Func  A function object with the above signature.
+     */
+    template<typename Func>
+    void forEachStatement(const Position& start, const Position& end, Func&& func) {
+      Wrap_iterateStackForward<Func> iterFunc{};
+      this->jacobiVector.evaluateForward(start.inner, end.inner, iterFunc, func);
+    }
+
+    /**
+     * @brief Call the function object for each statement of the tape.
+     *
+     * See forEachStatement(const Position&, const Position&, Func&&) for details.
+     *
+     * @param[in,out] func  The function object that is called for each statement.
+     *
+     * @tparam Func  A function object with the signature described in forEachStatement.
+     */
+    template<typename Func>
+    void forEachStatement(Func&& func) {
+      forEachStatement(this->getZeroPosition(), this->getPosition(), std::forward<Func>(func));
+    }
+
     /**
      * @brief Gather the general performance values of the tape.
      *
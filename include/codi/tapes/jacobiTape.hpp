@@ -127,6 +127,7 @@ namespace codi {
 
     friend TapeBaseModule<TapeTypes, JacobiTape>;  /**< No doc */
     friend StatementModule<TapeTypes, JacobiTape>;  /**< No doc */
+    friend ExternalFunctionModule<TapeTypes, JacobiTape>;  /**< No doc */
     friend ::codi::IOModule<TapeTypes, JacobiTape>;  /**< No doc */
 
     CODI_INLINE_REVERSE_TAPE_TYPES(TapeTypes::BaseTypes)
@@ -213,6 +214,7 @@ namespace codi {
       for(Index i = startPos + 1; i <= endPos; ++i) {
         this->adjoints[i] = GradientValue();
       }
+      this->markAdjointsClean(startPos + 1, endPos + 1);
     }
 
     using TapeBaseModule<TapeTypes, JacobiTape>::clearAdjoints;
@@ -358,6 +360,10 @@ namespace codi {
       AdjointInterfaceImpl<Real, Index, AdjointData> interface(adjointData);
 
       this->evaluateExtFunc(start, end, reverseFunc, this->jacobiVector, &interface, evalFunc, adjointData);
+
+      // The arguments of the statements have smaller indices than the start position.
+      this->sweepAdjointsBegin = 0;
+      this->sweepAdjointsEnd = start.inner.inner.inner + 1;
     }
 
     /**
@@ -402,6 +408,48 @@ namespace codi {
 
     WRAP_FUNCTION_TEMPLATE(Wrap_evaluateStackForward, evaluateStackForward);
 
+    /**
+     * @brief Call the function object for each statement in the stack.
+     *
+     * It has to hold startAdjPos <= endAdjPos.
+     *
+     * @param[in]     startAdjPos  The starting point in the expression evaluation.
+     * @param[in]       endAdjPos  The ending point in the expression evaluation.
+     * @param[in,out]        func  The function object that is called for each statement.
+     * @param[in,out]     dataPos  The current position in the jacobi and index vector. This value is used in the next invocation of this method.
+     * @param[in]      endDataPos  The end position in the jacobi and index vector.
+     * @param[in]        jacobies  The pointer to the jacobi vector.
+     * @param[in]         indices  The pointer to the index vector
+     * @param[in,out]     stmtPos  The current position in the statement vector. This value is used in the next invocation of this method.
+     * @param[in]      endStmtPos  The end position in the statement vector.
+     * @param[in]      statements  The pointer to the statement vector.
+     *
+     * @tparam Func  See forEachStatement for the signature.
+     */
+    template<typename Func>
+    static CODI_INLINE void iterateStackForward(const size_t& startAdjPos, const size_t& endAdjPos, Func& func,
+                                         size_t& dataPos, const size_t& endDataPos, Real* &jacobies, Index* &indices,
+                                         size_t& stmtPos, const size_t& endStmtPos, StatementInt* &statements) {
+      CODI_UNUSED(endDataPos);
+      CODI_UNUSED(endStmtPos);
+
+      size_t adjPos = startAdjPos;
+
+      while(adjPos < endAdjPos) {
+        ++adjPos;
+
+        if(StatementIntInputTag != statements[stmtPos]) {
+          const size_t nArgs = statements[stmtPos];
+          func((Index)adjPos, nArgs, &indices[dataPos], &jacobies[dataPos], (const char*)NULL);
+          dataPos += nArgs;
+        }
+
+        ++stmtPos;
+      }
+    }
+
+    WRAP_FUNCTION_TEMPLATE(Wrap_iterateStackForward, iterateStackForward);
+
     /**
      * @brief Evaluate the stack in forward order.
      *
@@ -422,6 +470,10 @@ namespace codi {
       AdjointInterfaceImpl<Real, Index, AdjointData> interface(adjointData);
 
       this->evaluateExtFuncForward(start, end, forwardFunc, this->jacobiVector, &interface, evalFunc, adjointData);
+
+      // Only the lhs values between the positions are written.
+      this->sweepAdjointsBegin = start.inner.inner.inner + 1;
+      this->sweepAdjointsEnd = end.inner.inner.inner + 1;
     }
 
     /**
@@ -474,6 +526,19 @@ namespace codi {
       registerInputInternal(value.value(), value.getGradientData());
     }
 
+    /**
+     * @brief Register an input variable whose index is managed by the caller.
+     *
+     * Same as registerInput for an index that does not belong to an active type, e.g. if statements are recorded with
+     * storeManual and pushJacobiManual on a tape that is not the global one.
+     *
+     * @param[out] index  Is assigned a non zero value.
+     */
+    CODI_INLINE void registerManualInput(Index& index) {
+      Real value = Real();
+      registerInputInternal(value, index);
+    }
+
     /**
      * @brief Modify the output of an external function such that the tape sees it as an active variable.
      *
@@ -498,6 +563,45 @@ namespace codi {
       registerOutputInternal(value.getValue(), value.getGradientData());
     }
 
+    /**
+     * @brief Call the function object for each statement between the start and the end position.
+     *
+     * The statements are visited in the order of the recording. The function object is called as
+     * \code{.cpp}
+     *   func(lhsIndex, nArgs, indices, jacobies, operation);
+     * \endcode
+     * with the types (const Index&, size_t, const Index*, const Real*, const char*). The Jacobians are the stored values of the tape and operation is always NULL.
+     *
+     * Input statements and external functions are skipped.
+     *
+     * It has to hold start <= end.
+     *
+     * @param[in]  start  The starting position.
+     * @param[in]    end  The ending position.
+     * @param[in,out] func  The function object that is called for each statement.
+     *
+     * @tparam Func  A function object with the above signature.
+     */
+    template<typename Func>
+    void forEachStatement(const Position& start, const Position& end, Func&& func) {
+      Wrap_iterateStackForward<Func> iterFunc{};
+      this->jacobiVector.evaluateForward(start.inner, end.inner, iterFunc, func);
+    }
+
+    /**
+     * @brief Call the function object for each statement of the tape.
+     *
+     * See forEachStatement(const Position&, const Position&, Func&&) for details.
+     *
+     * @param[in,out] func  The function object that is called for each statement.
+     *
+     * @tparam Func  A function object with the signature described in forEachStatement.
+     */
+    template<typename Func>
+    void forEachStatement(Func&& func) {
+      forEachStatement(this->getZeroPosition(), this->getPosition(), std::forward<Func>(func));
+    }
+
     /**
      * @brief Gather the general performance values of the tape.
      *
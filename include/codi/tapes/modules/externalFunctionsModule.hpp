@@ -31,6 +31,7 @@
 #include "../reverseTapeInterface.hpp"
 #include "../../configure.h"
 #include "../../tapeTypes.hpp"
+#include "../../tools/instrumentation.hpp"
 #include "../../tools/tapeValues.hpp"
 #include "../../typeFunctions.hpp"
 
@@ -203,7 +204,14 @@ namespace codi {
 
           (obj.*func)(curInnerPos, *endInnerPos, std::forward<Args>(args)...);
 
+#if CODI_EnableInstrumentation
+          Instrumentation::Clock::time_point extFuncStart = Instrumentation::now();
+#endif
           extFunc->evaluatePrimal(&obj, adjointInterface);
+#if CODI_EnableInstrumentation
+          cast().instrumentation.externalFunctionCalls += 1;
+          cast().instrumentation.externalFunctionTime += Instrumentation::elapsed(extFuncStart);
+#endif
 
           curInnerPos = *endInnerPos;
 
@@ -244,7 +252,14 @@ namespace codi {
 
            (obj.*func)(curInnerPos, *endInnerPos, std::forward<Args>(args)...);
 
+#if CODI_EnableInstrumentation
+           Instrumentation::Clock::time_point extFuncStart = Instrumentation::now();
+#endif
            extFunc->evaluateReverse(&obj, adjointInterface);
+#if CODI_EnableInstrumentation
+           cast().instrumentation.externalFunctionCalls += 1;
+           cast().instrumentation.externalFunctionTime += Instrumentation::elapsed(extFuncStart);
+#endif
 
            curInnerPos = *endInnerPos;
 
@@ -282,7 +297,14 @@ namespace codi {
 
           (obj.*func)(curInnerPos, *endInnerPos, std::forward<Args>(args)...);
 
+#if CODI_EnableInstrumentation
+          Instrumentation::Clock::time_point extFuncStart = Instrumentation::now();
+#endif
           extFunc->evaluateForward(&obj, adjointInterface);
+#if CODI_EnableInstrumentation
+          cast().instrumentation.externalFunctionCalls += 1;
+          cast().instrumentation.externalFunctionTime += Instrumentation::elapsed(extFuncStart);
+#endif
 
           curInnerPos = *endInnerPos;
 
@@ -118,6 +118,48 @@ namespace codi {
     // Protected functions for the communication with the including class
     // ----------------------------------------------------------------------
 
+      /**
+       * @brief Perform the adjoint update for one argument of a statement.
+       *
+       * Decrements dataPos and updates the adjoint of the argument at the new position. If ReversePrefetchDistance is
+       * set, the data for the argument ReversePrefetchDistance positions ahead is prefetched.
+       *
+       * @param[in]                  adj  The adjoint of the lhs of the statement.
+       * @param[in,out]         adjoints  The adjoint vector containing the adjoints of all variables.
+       * @param[in,out]          dataPos  The position inside the jacobi and indices vectors. It is decremented by one.
+       * @param[in]             jacobies  The jacobies from the arguments of the statement.
+       * @param[in]              indices  The indices from the arguments of the statements.
+       */
+      template<typename AdjointData>
+      static CODI_INLINE void incrementAdjoint(const AdjointData& adj, AdjointData* adjoints, size_t& dataPos, const Real* jacobies, const Index* indices) {
+        --dataPos;
+        if(0 != ReversePrefetchDistance && dataPos >= ReversePrefetchDistance) {
+          CODI_PREFETCH(&jacobies[dataPos - ReversePrefetchDistance], 0);
+          CODI_PREFETCH(&adjoints[indices[dataPos - ReversePrefetchDistance]], 1);
+        }
+        adjoints[indices[dataPos]] += adj * jacobies[dataPos];
+      }
+
+      /**
+       * @brief Perform the adjoint update for a statement with a fixed number of arguments.
+       *
+       * The loop has a compile time trip count and is unrolled by the compiler.
+       *
+       * @param[in]                  adj  The adjoint of the lhs of the statement.
+       * @param[in,out]         adjoints  The adjoint vector containing the adjoints of all variables.
+       * @param[in,out]          dataPos  The position inside the jacobi and indices vectors. It is decremented by size.
+       * @param[in]             jacobies  The jacobies from the arguments of the statement.
+       * @param[in]              indices  The indices from the arguments of the statements.
+       *
+       * @tparam size  The number of active arguments on the rhs.
+       */
+      template<size_t size, typename AdjointData>
+      static CODI_INLINE void incrementAdjointsFixed(const AdjointData& adj, AdjointData* adjoints, size_t& dataPos, const Real* jacobies, const Index* indices) {
+        for(size_t curVar = 0; curVar < size; ++curVar) {
+          incrementAdjoint(adj, adjoints, dataPos, jacobies, indices);
+        }
+      }
+
       /**
        * @brief Perform the adjoint update of the reverse AD sweep
        *
@@ -128,6 +170,9 @@ namespace codi {
        * The \f[ v_i \f] are the arguments of the statement and are taken from the input jacobi and indices.
        * The value \f[ \bar w \f] is taken from the input adj.
        *
+       * Statements with up to four arguments are dispatched to unrolled implementations, larger statements use a
+       * loop over the arguments.
+       *
        * @param[in]                  adj  The adjoint of the lhs of the statement.
        * @param[in,out]         adjoints  The adjoint vector containing the adjoints of all variables.
        * @param[in]      activeVariables  The number of active arguments on the rhs.
@@ -138,10 +183,24 @@ namespace codi {
        template<typename AdjointData>
        static CODI_INLINE void incrementAdjoints(const AdjointData& adj, AdjointData* adjoints, const StatementInt& activeVariables, size_t& dataPos, Real* &jacobies, Index* &indices) {
         ENABLE_CHECK(OptZeroAdjoint, !isTotalZero(adj)){
-          for(StatementInt curVar = 0; curVar < activeVariables; ++curVar) {
-            --dataPos;
-            adjoints[indices[dataPos]] += adj * jacobies[dataPos];
-
+          switch(activeVariables) {
+            case 1:
+              incrementAdjointsFixed<1>(adj, adjoints, dataPos, jacobies, indices);
+              break;
+            case 2:
+              incrementAdjointsFixed<2>(adj, adjoints, dataPos, jacobies, indices);
+              break;
+            case 3:
+              incrementAdjointsFixed<3>(adj, adjoints, dataPos, jacobies, indices);
+              break;
+            case 4:
+              incrementAdjointsFixed<4>(adj, adjoints, dataPos, jacobies, indices);
+              break;
+            default:
+              for(StatementInt curVar = 0; curVar < activeVariables; ++curVar) {
+                incrementAdjoint(adj, adjoints, dataPos, jacobies, indices);
+              }
+              break;
           }
         } else {
           dataPos -= activeVariables;
@@ -31,6 +31,8 @@
 #include "../reverseTapeInterface.hpp"
 #include "../../configure.h"
 #include "../../tapeTypes.hpp"
+#include "../../tools/instrumentation.hpp"
+#include "../../tools/statementProfile.hpp"
 #include "../../tools/tapeValues.hpp"
 #include "../../typeFunctions.hpp"
 #include "../primalTapeExpressions.hpp"
@@ -289,6 +291,30 @@ namespace codi {
     // Protected function for the communication with the including class
     // ----------------------------------------------------------------------
 
+      /**
+       * @brief Copy the indices of the active arguments of a statement.
+       *
+       * The passive arguments are stored with the indices 1 to passiveActives, which are reserved by the index handler.
+       *
+       * @param[out] activeIndices  The indices of the active arguments.
+       * @param[in]        indices  The indices of all arguments.
+       * @param[in]           size  The number of all arguments.
+       * @param[in] passiveActives  The number of passive arguments.
+       *
+       * @return The number of active arguments.
+       */
+      static CODI_INLINE size_t getActiveIndices(Index* activeIndices, const Index* indices, size_t size, const StatementInt& passiveActives) {
+        size_t nActive = 0;
+        for(size_t i = 0; i < size; ++i) {
+          if(indices[i] > (Index)passiveActives) {
+            activeIndices[nActive] = indices[i];
+            nActive += 1;
+          }
+        }
+
+        return nActive;
+      }
+
       /**
        * @brief Swap the data of the primal value module with the data of the other primal tape module.
        *
@@ -371,6 +397,9 @@ namespace codi {
           *passiveVariableCount += 1;
           pushIndex = *passiveVariableCount;
           passiveValueVector.setDataAndMove(value);
+#if CODI_EnableInstrumentation
+          cast().instrumentation.passiveValuePushes += 1;
+#endif
         }
 
         indexVector.setDataAndMove(pushIndex);
@@ -378,6 +407,18 @@ namespace codi {
 
     public:
 
+      /**
+       * @brief The profile of the reverse evaluation per statement handle.
+       *
+       * The profile is only gathered if CODI_EnableStatementProfile is set. It is shared by all tapes with the same
+       * handle type and is not thread-safe.
+       *
+       * @return The global profile for the handles of this tape.
+       */
+      static StatementProfile<typename HandleFactory::Handle>& getStatementProfile() {
+        return StatementProfile<typename HandleFactory::Handle>::get();
+      }
+
       /**
        * @brief Evaluate one handle in the primal sweep.
        *
@@ -166,21 +166,27 @@ namespace codi {
 
         size_t startSize = cast().jacobiVector.getChunkPosition();
 
-#if !CODI_EnableCombineJacobianArguments
-        // If enabled insertData is defined as a member
-        auto& insertData = cast().jacobiVector;
+#if CODI_EnableCombineJacobianArguments
+        // Identifiers can only appear several times if the expression has more than one active argument. The number
+        // is known at compile time, all other expressions are pushed directly.
+        if(1 < ExpressionTraits<Rhs>::maxActiveVariables) {
+          rhs.template calcGradient(insertData);
+          rhs.template pushLazyJacobies(insertData);
+
+          insertData.storeData(cast().jacobiVector);
+
+          return cast().jacobiVector.getChunkPosition() - startSize;
+        }
 #endif
 
+        auto& jacobiData = cast().jacobiVector;
+
         // Push the regular Jacobian arguments
-        rhs.template calcGradient(insertData);
+        rhs.template calcGradient(jacobiData);
 
         // Push Jacobians from ReferencReal arguments
-        rhs.template pushLazyJacobies(insertData);
+        rhs.template pushLazyJacobies(jacobiData);
 
-        // Store the Jacobians if the cobine optimization is enabled
-#if CODI_EnableCombineJacobianArguments
-        insertData.storeData(cast().jacobiVector);
-#endif
         return cast().jacobiVector.getChunkPosition() - startSize;
       }
 
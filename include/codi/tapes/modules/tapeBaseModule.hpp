@@ -28,10 +28,14 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "../chunk.hpp"
 #include "../reverseTapeInterface.hpp"
 #include "../../configure.h"
 #include "../../tapeTypes.hpp"
+#include "../../tools/instrumentation.hpp"
+#include "../../tools/memoryAllocation.hpp"
 #include "../../tools/tapeValues.hpp"
 #include "../../typeFunctions.hpp"
 
@@ -111,17 +115,57 @@ namespace codi {
       /** @brief The current size of the adjoint vector. */
       Index adjointsSize;
 
+      /** @brief The size of the reserved address space for the adjoint vector in bytes. Zero if no reservation is used. */
+      size_t adjointsReserved;
+
+      /**
+       * @brief First entry of the range in the adjoint vector that might be non-zero.
+       *
+       * The range [adjointsDirtyBegin, adjointsDirtyEnd) is extended by all operations that write to the adjoint vector
+       * and is used by clearAdjoints() to reset only the entries that might have been written. The range is empty if
+       * adjointsDirtyBegin >= adjointsDirtyEnd.
+       */
+      Index adjointsDirtyBegin;
+
+      /** @brief End of the range in the adjoint vector that might be non-zero. See adjointsDirtyBegin. */
+      Index adjointsDirtyEnd;
+
+      /**
+       * @brief First entry of the range in the adjoint vector that was written by the last sweep.
+       *
+       * The range is set by evaluateInternal and evaluateForwardInternal of the tape implementation. Tapes with a
+       * linear index handler derive it from the positions of the sweep, the other tapes collect the indices in the
+       * evaluation loops.
+       */
+      Index sweepAdjointsBegin;
+
+      /** @brief End of the range in the adjoint vector that was written by the last sweep. See sweepAdjointsBegin. */
+      Index sweepAdjointsEnd;
+
       /**
        * @brief Determines if statements are recorded or ignored.
        */
       bool active;
 
+#if CODI_EnableInstrumentation
+      /** @brief The counters of the tape, the counters of the vectors and the index handler are stored there. */
+      Instrumentation instrumentation;
+
+      /** @brief Time of the last setActive call. */
+      Instrumentation::Clock::time_point recordStart;
+#endif
+
       /**
        * @brief Default constructor
        */
       TapeBaseModule() :
         adjoints(NULL),
         adjointsSize(0),
+        adjointsReserved(0),
+        adjointsDirtyBegin(0),
+        adjointsDirtyEnd(0),
+        sweepAdjointsBegin(0),
+        sweepAdjointsEnd(0),
         active(false)
       {}
 
@@ -163,6 +207,10 @@ namespace codi {
         values.addData("Memory allocated", memoryAdjoints, true, true);
 
         cast().indexHandler.addValues(values);
+
+#if CODI_EnableInstrumentation
+        getInstrumentation().addValues(values);
+#endif
       }
 
       /**
@@ -171,6 +219,10 @@ namespace codi {
        * @param[in] size The new size for the adjoint vector.
        */
       void resizeAdjoints(const Index& size) {
+#if CODI_EnableInstrumentation
+        instrumentation.adjointResizes += 1;
+#endif
+
         Index oldSize = adjointsSize;
         adjointsSize = size;
 
@@ -178,14 +230,103 @@ namespace codi {
           adjoints[i].~GradientValue();
         }
 
-        adjoints = (GradientValue*)realloc((void*)adjoints, sizeof(GradientValue) * (size_t)adjointsSize);
+        const size_t oldBytes = sizeof(GradientValue) * (size_t)oldSize;
+        const size_t newBytes = sizeof(GradientValue) * (size_t)adjointsSize;
+        if(CODI_HasMMap && 0 != AdjointReserveSize) {
+          resizeReservedAdjoints(oldBytes, newBytes);
+        } else {
+          adjoints = (GradientValue*)MemoryAllocation::reallocate((void*)adjoints, oldBytes, newBytes);
+        }
+
+        if(oldSize < adjointsSize) {
+          MemoryAllocation::constructArray(adjoints, (size_t)oldSize, (size_t)adjointsSize);
+        }
+      }
 
-        if(NULL == adjoints) {
-          throw std::bad_alloc();
+      /**
+       * @brief Helper function: Grows the committed part of the reserved adjoint vector.
+       *
+       * If the reservation is too small, the vector is moved to a new reservation of at least twice the size.
+       *
+       * @param[in] oldBytes  The size of the adjoint vector in bytes before the resize.
+       * @param[in] newBytes  The size of the adjoint vector in bytes after the resize.
+       */
+      void resizeReservedAdjoints(const size_t oldBytes, const size_t newBytes) {
+        if(adjointsReserved < newBytes) {
+          const size_t reserveBytes = std::max(AdjointReserveSize, 2 * newBytes);
+          GradientValue* newAdjoints = (GradientValue*)MemoryAllocation::reserve(reserveBytes);
+          MemoryAllocation::commit(newAdjoints, 0, newBytes);
+
+          if(NULL != adjoints) {
+            memcpy((void*)newAdjoints, (void*)adjoints, std::min(oldBytes, newBytes));
+            MemoryAllocation::release(adjoints, adjointsReserved);
+          }
+
+          adjoints = newAdjoints;
+          adjointsReserved = reserveBytes;
+        } else if(oldBytes < newBytes) {
+          MemoryAllocation::commit(adjoints, oldBytes, newBytes);
+        }
+      }
+
+      /**
+       * @brief Helper function: Extend the range of adjoint entries that might be non-zero by [begin, end).
+       *
+       * @param[in] begin  The first entry that might have been written.
+       * @param[in]   end  The entry after the last one that might have been written.
+       */
+      CODI_INLINE void markAdjointsDirty(const Index& begin, const Index& end) {
+        if(begin >= end) {
+          // nothing was written
+        } else if(adjointsDirtyBegin >= adjointsDirtyEnd) {
+          adjointsDirtyBegin = begin;
+          adjointsDirtyEnd = end;
+        } else {
+          adjointsDirtyBegin = std::min(adjointsDirtyBegin, begin);
+          adjointsDirtyEnd = std::max(adjointsDirtyEnd, end);
+        }
+      }
+
+      /**
+       * @brief Helper function: Shrink the range of adjoint entries that might be non-zero after [begin, end) was cleared.
+       *
+       * The range is only reduced if the cleared entries cover one of its ends.
+       *
+       * @param[in] begin  The first entry that was cleared.
+       * @param[in]   end  The entry after the last one that was cleared.
+       */
+      CODI_INLINE void markAdjointsClean(const Index& begin, const Index& end) {
+        if(begin <= adjointsDirtyBegin) {
+          adjointsDirtyBegin = std::max(adjointsDirtyBegin, end);
+        }
+        if(end >= adjointsDirtyEnd) {
+          adjointsDirtyEnd = std::min(adjointsDirtyEnd, begin);
         }
+      }
 
-        for(Index i = oldSize; i < adjointsSize; ++i) {
-          new (adjoints + i) GradientValue();
+      /**
+       * @brief Helper function: Mark the entries that were written by the last sweep with the internal adjoint vector.
+       */
+      CODI_INLINE void markAdjointsDirtyForEvaluation() {
+        markAdjointsDirty(sweepAdjointsBegin, sweepAdjointsEnd);
+      }
+
+      /**
+       * @brief Helper function: Set the range of the last sweep from the indices that were found in the evaluation loops.
+       *
+       * External functions can write to any adjoint, if the sweep contains one, the range covers all indices.
+       *
+       * @param[in] hasExternalFunctions  True if external functions were evaluated in the sweep.
+       * @param[in]             minIndex  The smallest index that was written.
+       * @param[in]             maxIndex  The largest index that was written.
+       */
+      CODI_INLINE void setSweepAdjoints(bool hasExternalFunctions, const Index& minIndex, const Index& maxIndex) {
+        if(hasExternalFunctions) {
+          sweepAdjointsBegin = 0;
+          sweepAdjointsEnd = cast().indexHandler.getMaximumGlobalIndex() + 1;
+        } else {
+          sweepAdjointsBegin = minIndex;
+          sweepAdjointsEnd = maxIndex + 1;
         }
       }
 
@@ -203,9 +344,16 @@ namespace codi {
        */
       void cleanTapeBase() {
         if(NULL != adjoints) {
-          free(adjoints);
+          if(0 != adjointsReserved) {
+            MemoryAllocation::release(adjoints, adjointsReserved);
+          } else {
+            MemoryAllocation::free(adjoints, sizeof(GradientValue) * (size_t)adjointsSize);
+          }
           adjoints = NULL;
           adjointsSize = 0;
+          adjointsReserved = 0;
+          adjointsDirtyBegin = 0;
+          adjointsDirtyEnd = 0;
         }
       }
 
@@ -217,7 +365,16 @@ namespace codi {
       void swapTapeBaseModule(Tape& other) {
         std::swap(adjoints, other.adjoints);
         std::swap(adjointsSize, other.adjointsSize);
+        std::swap(adjointsReserved, other.adjointsReserved);
+        std::swap(adjointsDirtyBegin, other.adjointsDirtyBegin);
+        std::swap(adjointsDirtyEnd, other.adjointsDirtyEnd);
+        std::swap(sweepAdjointsBegin, other.sweepAdjointsBegin);
+        std::swap(sweepAdjointsEnd, other.sweepAdjointsEnd);
         std::swap(active, other.active);
+#if CODI_EnableInstrumentation
+        std::swap(instrumentation, other.instrumentation);
+        std::swap(recordStart, other.recordStart);
+#endif
 
         // the index handler is not swaped because it is either swaped in the recursive call to of the data vectors
         // or it is handled by the including class
@@ -329,6 +486,9 @@ namespace codi {
        *
        * An index of 0 will raise an codiAssert exception.
        *
+       * The entry is marked as written when the reference is created. A reference must not be kept across a call to
+       * clearAdjoints, since values that are written through it afterwards are not reset by the next clearAdjoints.
+       *
        * @param[in] index The index of the active type.
        * @return The reference to the gradient data.
        */
@@ -340,6 +500,7 @@ namespace codi {
         if(adjointsSize <= index) {
           resizeAdjoints(cast().indexHandler.getMaximumGlobalIndex() + 1);
         }
+        markAdjointsDirty(index, index + 1);
 
         return adjoints[index];
       }
@@ -360,13 +521,28 @@ namespace codi {
 
       /**
        * @brief Sets all adjoint/gradients to zero.
+       *
+       * Only the entries that might have been written since the last call are reset. These are the ranges written by
+       * the sweeps with the internal adjoint vector and the entries accessed with gradient().
        */
       CODI_INLINE void clearAdjoints(){
+#if CODI_EnableInstrumentation
+        Instrumentation::Clock::time_point clearStart = Instrumentation::now();
+#endif
+
         if(NULL != adjoints) {
-          for(Index i = 0; i < adjointsSize; ++i) {
+          Index end = std::min(adjointsDirtyEnd, adjointsSize);
+          for(Index i = adjointsDirtyBegin; i < end; ++i) {
             adjoints[i] = GradientValue();
           }
         }
+
+#if CODI_EnableInstrumentation
+        instrumentation.clearTime += Instrumentation::elapsed(clearStart);
+#endif
+
+        adjointsDirtyBegin = 0;
+        adjointsDirtyEnd = 0;
       }
 
       /**
@@ -386,8 +562,16 @@ namespace codi {
        * @param[in] pos Reset the state of the tape to the given position.
        */
       CODI_INLINE void reset(const Position& pos) {
+#if CODI_EnableInstrumentation
+        Instrumentation::Clock::time_point clearStart = Instrumentation::now();
+#endif
+
         cast().clearAdjoints(cast().getPosition(), pos);
 
+#if CODI_EnableInstrumentation
+        instrumentation.clearTime += Instrumentation::elapsed(clearStart);
+#endif
+
         // reset will be done iteratively through the vectors
         cast().resetInternal(pos);
       }
@@ -420,7 +604,15 @@ namespace codi {
        */
       template<typename AdjointData>
       CODI_NO_INLINE void evaluate(const Position& start, const Position& end, AdjointData* adjointData) {
+#if CODI_EnableInstrumentation
+        Instrumentation::Clock::time_point evaluateStart = Instrumentation::now();
+#endif
+
         cast().evaluateInternal(start, end, adjointData);
+
+#if CODI_EnableInstrumentation
+        instrumentation.evaluateTime += Instrumentation::elapsed(evaluateStart);
+#endif
       }
 
       /**
@@ -435,6 +627,8 @@ namespace codi {
         resizeAdjointsToIndexSize();
 
         evaluate(start, end, adjoints);
+
+        markAdjointsDirtyForEvaluation();
       }
 
       /**
@@ -457,7 +651,15 @@ namespace codi {
        */
       template<typename AdjointData>
       CODI_NO_INLINE void evaluateForward(const Position& start, const Position& end, AdjointData* adjointData) {
+#if CODI_EnableInstrumentation
+        Instrumentation::Clock::time_point evaluateStart = Instrumentation::now();
+#endif
+
         cast().evaluateForwardInternal(start, end, adjointData);
+
+#if CODI_EnableInstrumentation
+        instrumentation.evaluateTime += Instrumentation::elapsed(evaluateStart);
+#endif
       }
 
       /**
@@ -472,6 +674,8 @@ namespace codi {
         resizeAdjointsToIndexSize();
 
         evaluateForward(start, end, adjoints);
+
+        markAdjointsDirtyForEvaluation();
       }
 
       /**
@@ -504,6 +708,12 @@ namespace codi {
        * @brief Start recording.
        */
       CODI_INLINE void setActive(){
+#if CODI_EnableInstrumentation
+        if(!active) {
+          recordStart = Instrumentation::now();
+        }
+#endif
+
         active = true;
       }
 
@@ -511,6 +721,12 @@ namespace codi {
        * @brief Stop recording.
        */
       CODI_INLINE void setPassive(){
+#if CODI_EnableInstrumentation
+        if(active) {
+          instrumentation.recordTime += Instrumentation::elapsed(recordStart);
+        }
+#endif
+
         active = false;
       }
 
@@ -540,6 +756,32 @@ namespace codi {
         return Index(-1);
       }
 
+#if CODI_EnableInstrumentation
+      /**
+       * @brief Get the instrumentation counters of this tape.
+       *
+       * The counters of the tape are combined with the counters of the data vectors and the index handler.
+       *
+       * @return The counters of this tape.
+       */
+      Instrumentation getInstrumentation() const {
+        Instrumentation counters = instrumentation;
+        cast().getRootVector().addInstrumentation(counters);
+        cast().indexHandler.addInstrumentation(counters);
+
+        return counters;
+      }
+
+      /**
+       * @brief Set the instrumentation counters of this tape to zero.
+       */
+      void resetInstrumentation() {
+        instrumentation.reset();
+        cast().getRootVector().resetInstrumentation();
+        cast().indexHandler.resetInstrumentation();
+      }
+#endif
+
       /**
        * @brief Prints statistics about the tape on the screen or into a stream
        *
@@ -29,7 +29,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <limits>
 #include <tuple>
 
 #include "../activeReal.hpp"
@@ -45,6 +47,7 @@
 #include "reverseTapeInterface.hpp"
 #include "singleChunkVector.hpp"
 #include "../tapeTypes.hpp"
+#include "../tools/statementProfile.hpp"
 #include "../tools/tapeValues.hpp"
 
 namespace codi {
@@ -138,6 +141,7 @@ namespace codi {
 
     friend TapeBaseModule<TapeTypes, PrimalValueIndexTape>;  /**< No doc */
     friend PrimalValueModule<TapeTypes, PrimalValueIndexTape>;  /**< No doc */
+    friend ExternalFunctionModule<TapeTypes, PrimalValueIndexTape>;  /**< No doc */
     friend ::codi::IOModule<TapeTypes, PrimalValueIndexTape>;  /**< No doc */
 
     CODI_INLINE_REVERSE_TAPE_TYPES(TapeTypes::BaseTypes)
@@ -382,6 +386,8 @@ namespace codi {
      *
      * @param[in,out]   adjointData  The vector of the adjoint variables.
      * @param[in,out]  primalVector  The vector of the primal variables.
+     * @param[in,out]      minIndex  The smallest index of the written adjoints is added.
+     * @param[in,out]      maxIndex  The largest index of the written adjoints is added.
      * @param[in,out]   constantPos  The current position in the constant data vector. It will decremented in the method.
      * @param[in]    endConstantPos  The ending position in the constant data vector.
      * @param[in]         constants  The constant values in the rhs expressions.
@@ -398,7 +404,7 @@ namespace codi {
      * @tparam AdjointData The data for the adjoint vector it needs to support add, multiply and comparison operations.
      */
     template<typename AdjointData>
-    static CODI_INLINE void evaluateStackReverse(AdjointData* adjointData, Real* primalVector,
+    static CODI_INLINE void evaluateStackReverse(AdjointData* adjointData, Real* primalVector, Index& minIndex, Index& maxIndex,
                                           size_t& constantPos, const size_t& endConstantPos, PassiveReal* &constants,
                                           size_t& passivePos, const size_t& endPassivePos, Real* &passives,
                                           size_t& indexPos, const size_t& endIndexPos, Index* &indices,
@@ -417,15 +423,39 @@ namespace codi {
           adjointData->setLhsAdjoint(lhsIndex);
           if(StatementIntInputTag != passiveActiveReal[stmtPos]) {
             adjointData->resetAdjointVec(lhsIndex);
+            const size_t oldIndexPos = indexPos;
 
+#if CODI_EnableStatementProfile
+            uint64_t profileStart = StatementProfile<Handle>::now();
+#endif
             HandleFactory::template callHandle<PrimalValueIndexTape<TapeTypes> >(statements[stmtPos], 1.0, passiveActiveReal[stmtPos], indexPos, indices, passivePos, passives, constantPos, constants, primalVector, adjointData);
+#if CODI_EnableStatementProfile
+            StatementProfile<Handle>::get().addEvaluation(statements[stmtPos], profileStart);
+#endif
+
+            for(size_t curArg = indexPos; curArg < oldIndexPos; ++curArg) {
+              minIndex = std::min(minIndex, indices[curArg]);
+              maxIndex = std::max(maxIndex, indices[curArg]);
+            }
           }
 #else
           const GradientValue adj = adjointData[lhsIndex];
           if(StatementIntInputTag != passiveActiveReal[stmtPos]) {
             adjointData[lhsIndex] = GradientValue();
+            const size_t oldIndexPos = indexPos;
 
+#if CODI_EnableStatementProfile
+            uint64_t profileStart = StatementProfile<Handle>::now();
+#endif
             HandleFactory::template callHandle<PrimalValueIndexTape<TapeTypes> >(statements[stmtPos], adj, passiveActiveReal[stmtPos], indexPos, indices, passivePos, passives, constantPos, constants, primalVector, adjointData);
+#if CODI_EnableStatementProfile
+            StatementProfile<Handle>::get().addEvaluation(statements[stmtPos], profileStart);
+#endif
+
+            for(size_t curArg = indexPos; curArg < oldIndexPos; ++curArg) {
+              minIndex = std::min(minIndex, indices[curArg]);
+              maxIndex = std::max(maxIndex, indices[curArg]);
+            }
           }
 #endif
       }
@@ -440,6 +470,8 @@ namespace codi {
      *
      * @param[in,out]   adjointData  The vector of the adjoint variables.
      * @param[in,out]  primalVector  The vector of the primal variables.
+     * @param[in,out]      minIndex  The smallest index of the written adjoints is added.
+     * @param[in,out]      maxIndex  The largest index of the written adjoints is added.
      * @param[in,out]   constantPos  The current position in the constant data vector. It will decremented in the method.
      * @param[in]    endConstantPos  The ending position in the constant data vector.
      * @param[in]         constants  The constant values in the rhs expressions.
@@ -456,7 +488,7 @@ namespace codi {
      * @tparam AdjointData The data for the adjoint vector it needs to support add, multiply and comparison operations.
      */
     template<typename AdjointData>
-    static CODI_INLINE void evaluateStackForward(AdjointData* adjointData, Real* primalVector,
+    static CODI_INLINE void evaluateStackForward(AdjointData* adjointData, Real* primalVector, Index& minIndex, Index& maxIndex,
                                           size_t& constantPos, const size_t& endConstantPos, PassiveReal* &constants,
                                           size_t& passivePos, const size_t& endPassivePos, Real* &passives,
                                           size_t& indexPos, const size_t& endIndexPos, Index* &indices,
@@ -480,6 +512,8 @@ namespace codi {
 #else
           adjointData[lhsIndex] = lhsAdj;
 #endif
+          minIndex = std::min(minIndex, lhsIndex);
+          maxIndex = std::max(maxIndex, lhsIndex);
         }
 
         stmtPos += 1;
@@ -530,6 +564,60 @@ namespace codi {
 
     WRAP_FUNCTION(Wrap_evaluateStackPrimal, evaluateStackPrimal);
 
+    /**
+     * @brief Call the function object for each statement in the stack.
+     *
+     * It has to hold start <= end.
+     *
+     * @param[in,out]          func  The function object that is called for each statement.
+     * @param[in,out]  primalVector  The vector of the primal variables.
+     * @param[in,out]   constantPos  The current position in the constant data vector. It will incremented in the method.
+     * @param[in]    endConstantPos  The ending position in the constant data vector.
+     * @param[in]         constants  The constant values in the rhs expressions.
+     * @param[in,out]    passivePos  The current position in the passive data vector. It will incremented in the method.
+     * @param[in]     endPassivePos  The ending position in the passive data vector.
+     * @param[in]          passives  The passive values in the rhs expressions.
+     * @param[in,out]      indexPos  The current position for the index data. It will incremented in the method.
+     * @param[in]       endIndexPos  The ending position for the index data.
+     * @param[in]           indices  The indices for the arguments of the rhs.
+     * @param[in,out]       stmtPos  The current position in the statement data. It will incremented in the method.
+     * @param[in]        endStmtPos  The ending position for statement data.
+     * @param[in]        lhsIndices  The indices from the lhs of each statement.
+     * @param[in]     storedPrimals  The overwritten primal from the primal vector.
+     * @param[in]        statements  The vector with the handles for each statement.
+     * @param[in] passiveActiveReal  The number passive values for each statement.
+     *
+     * @tparam Func  See forEachStatement for the signature.
+     */
+    template<typename Func>
+    static CODI_INLINE void iterateStackForward(Func& func, Real* primalVector,
+                                         size_t& constantPos, const size_t& endConstantPos, PassiveReal* &constants,
+                                         size_t& passivePos, const size_t& endPassivePos, Real* &passives,
+                                         size_t& indexPos, const size_t& endIndexPos, Index* &indices,
+                                         size_t& stmtPos, const size_t& endStmtPos, Index* lhsIndices, Real* storedPrimals,
+                                         Handle* &statements, StatementInt* &passiveActiveReal) {
+      CODI_UNUSED(storedPrimals);
+      CODI_UNUSED(endConstantPos);
+      CODI_UNUSED(endPassivePos);
+      CODI_UNUSED(endIndexPos);
+
+      Index activeIndices[MaxStatementIntSize];
+
+      while(stmtPos < endStmtPos) {
+        if(StatementIntInputTag != passiveActiveReal[stmtPos]) {
+          const size_t argStart = indexPos;
+          HandleFactory::template callPrimalHandle<PrimalValueIndexTape<TapeTypes> >(statements[stmtPos], passiveActiveReal[stmtPos], indexPos, indices, passivePos, passives, constantPos, constants, primalVector);
+
+          const size_t nArgs = PrimalValueModule<TapeTypes, PrimalValueIndexTape<TapeTypes>>::getActiveIndices(activeIndices, &indices[argStart], indexPos - argStart, passiveActiveReal[stmtPos]);
+          func(lhsIndices[stmtPos], nArgs, (const Index*)activeIndices, (const Real*)NULL, HandleFactory::getHandleName(statements[stmtPos]));
+        }
+
+        stmtPos += 1;
+      }
+    }
+
+    WRAP_FUNCTION_TEMPLATE(Wrap_iterateStackForward, iterateStackForward);
+
 
     /**
      * @brief Allocates a copy of the primal vector that is used in the evaluation.
@@ -560,9 +648,14 @@ namespace codi {
       AdjVecInterface<AdjointData> interface(adjointData, primalsCopy);
       AdjVecType<AdjointData>* adjVec = this->wrapAdjointVector(interface, adjointData);
 
+      Index minIndex = std::numeric_limits<Index>::max();
+      Index maxIndex = Index();
+
       Wrap_evaluateStackReverse<AdjVecType<AdjointData>> evalFunc{};
-      auto reverseFunc = &TapeTypes::ConstantValueVector::template evaluateReverse<decltype(evalFunc), AdjVecType<AdjointData>*&, Real*&>;
-      this->evaluateExtFunc(start, end, reverseFunc, this->constantValueVector, &interface, evalFunc, adjVec, primalsCopy);
+      auto reverseFunc = &TapeTypes::ConstantValueVector::template evaluateReverse<decltype(evalFunc), AdjVecType<AdjointData>*&, Real*&, Index&, Index&>;
+      this->evaluateExtFunc(start, end, reverseFunc, this->constantValueVector, &interface, evalFunc, adjVec, primalsCopy, minIndex, maxIndex);
+
+      this->setSweepAdjoints(start.chunk != end.chunk || start.data != end.data, minIndex, maxIndex);
 
       if(!useCopy) {
         std::swap(this->primals, primalsCopy);
@@ -616,9 +709,14 @@ namespace codi {
       AdjVecInterface<AdjointData> interface(adjointData, primalsCopy);
       AdjVecType<AdjointData>* adjVec = this->wrapAdjointVector(interface, adjointData);
 
+      Index minIndex = std::numeric_limits<Index>::max();
+      Index maxIndex = Index();
+
       Wrap_evaluateStackForward<AdjVecType<AdjointData>> evalFunc{};
-      auto forwardFunc = &TapeTypes::ConstantValueVector::template evaluateForward<decltype(evalFunc), AdjVecType<AdjointData>*&, Real*&>;
-      this->evaluateExtFuncForward(start, end, forwardFunc, this->constantValueVector, &interface, evalFunc, adjVec, primalsCopy);
+      auto forwardFunc = &TapeTypes::ConstantValueVector::template evaluateForward<decltype(evalFunc), AdjVecType<AdjointData>*&, Real*&, Index&, Index&>;
+      this->evaluateExtFuncForward(start, end, forwardFunc, this->constantValueVector, &interface, evalFunc, adjVec, primalsCopy, minIndex, maxIndex);
+
+      this->setSweepAdjoints(start.chunk != end.chunk || start.data != end.data, minIndex, maxIndex);
 
       if(!useCopy) {
         std::swap(this->primals, primalsCopy);
@@ -688,9 +786,18 @@ namespace codi {
 
       this->resizeAdjointsToIndexSize();
 
+#if CODI_EnableInstrumentation
+      Instrumentation::Clock::time_point evaluateStart = Instrumentation::now();
+#endif
+
       evaluateInternal(start, end, this->adjoints, false);
+      this->markAdjointsDirtyForEvaluation();
 
       evaluatePrimalInternal(end, start);
+
+#if CODI_EnableInstrumentation
+      this->instrumentation.evaluateTime += Instrumentation::elapsed(evaluateStart);
+#endif
     }
 
     /**
@@ -707,9 +814,18 @@ namespace codi {
 
       this->resizeAdjointsToIndexSize();
 
+#if CODI_EnableInstrumentation
+      Instrumentation::Clock::time_point evaluateStart = Instrumentation::now();
+#endif
+
       this->resetPrimalValues(start);
 
       evaluateForwardInternal(start, end, this->adjoints, false);
+      this->markAdjointsDirtyForEvaluation();
+
+#if CODI_EnableInstrumentation
+      this->instrumentation.evaluateTime += Instrumentation::elapsed(evaluateStart);
+#endif
     }
 
     /**
@@ -798,6 +914,50 @@ namespace codi {
       return usePrimalCopy;
     }
 
+    /**
+     * @brief Call the function object for each statement between the start and the end position.
+     *
+     * The statements are visited in the order of the recording. The function object is called as
+     * \code{.cpp}
+     *   func(lhsIndex, nArgs, indices, jacobies, operation);
+     * \endcode
+     * with the types (const Index&, size_t, const Index*, const Real*, const char*). The primal value tapes do not store
+     * Jacobians, therefore jacobies is always NULL. The operation is the mangled type name of the expression if the
+     * handle factory provides it, otherwise NULL. Only the active arguments are given in indices.
+     *
+     * The primal values of the statements are evaluated in order to determine the arguments. The handle factory needs
+     * to support primal evaluations.
+     *
+     * Input statements and external functions are skipped.
+     *
+     * It has to hold start <= end.
+     *
+     * @param[in]  start  The starting position.
+     * @param[in]    end  The ending position.
+     * @param[in,out] func  The function object that is called for each statement.
+     *
+     * @tparam Func  A function object with the above signature.
+     */
+    template<typename Func>
+    void forEachStatement(const Position& start, const Position& end, Func&& func) {
+      Wrap_iterateStackForward<Func> iterFunc{};
+      this->constantValueVector.evaluateForward(start.inner, end.inner, iterFunc, func, this->primals);
+    }
+
+    /**
+     * @brief Call the function object for each statement of the tape.
+     *
+     * See forEachStatement(const Position&, const Position&, Func&&) for details.
+     *
+     * @param[in,out] func  The function object that is called for each statement.
+     *
+     * @tparam Func  A function object with the signature described in forEachStatement.
+     */
+    template<typename Func>
+    void forEachStatement(Func&& func) {
+      forEachStatement(this->getZeroPosition(), this->getPosition(), std::forward<Func>(func));
+    }
+
     /**
      * @brief Gather the general performance values of the tape.
      *
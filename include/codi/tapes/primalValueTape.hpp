@@ -45,6 +45,7 @@
 #include "reverseTapeInterface.hpp"
 #include "singleChunkVector.hpp"
 #include "../tapeTypes.hpp"
+#include "../tools/statementProfile.hpp"
 #include "../tools/tapeValues.hpp"
 
 namespace codi {
@@ -138,6 +139,7 @@ namespace codi {
 
     friend TapeBaseModule<TapeTypes, PrimalValueTape>;  /**< No doc */
     friend PrimalValueModule<TapeTypes, PrimalValueTape>;  /**< No doc */
+    friend ExternalFunctionModule<TapeTypes, PrimalValueTape>;  /**< No doc */
     friend ::codi::IOModule<TapeTypes, PrimalValueTape>;  /**< No doc */
 
     CODI_INLINE_REVERSE_TAPE_TYPES(TapeTypes::BaseTypes)
@@ -223,6 +225,7 @@ namespace codi {
       for(Index i = startPos + 1; i <= endPos; ++i) {
         this->adjoints[i] = GradientValue();
       }
+      this->markAdjointsClean(startPos + 1, endPos + 1);
     }
     using TapeBaseModule<TapeTypes, PrimalValueTape>::clearAdjoints;
 
@@ -364,10 +367,16 @@ namespace codi {
         --adjPos;
 
         if(StatementIntInputTag != passiveActiveReal[stmtPos]) {
+#if CODI_EnableStatementProfile
+          uint64_t profileStart = StatementProfile<Handle>::now();
+#endif
 #if CODI_EnableVariableAdjointInterfaceInPrimalTapes
           HandleFactory::template callHandle<PrimalValueTape<TapeTypes> >(statements[stmtPos], 1.0, passiveActiveReal[stmtPos], indexPos, indices, passivePos, passives, constantPos, constants, primalData, adjointData);
 #else
           HandleFactory::template callHandle<PrimalValueTape<TapeTypes> >(statements[stmtPos], adj, passiveActiveReal[stmtPos], indexPos, indices, passivePos, passives, constantPos, constants, primalData, adjointData);
+#endif
+#if CODI_EnableStatementProfile
+          StatementProfile<Handle>::get().addEvaluation(statements[stmtPos], profileStart);
 #endif
         }
       }
@@ -478,6 +487,64 @@ namespace codi {
 
     WRAP_FUNCTION(Wrap_evaluateStackPrimal, evaluateStackPrimal);
 
+    /**
+     * @brief Call the function object for each statement in the stack.
+     *
+     * It has to hold startAdjPos <= endAdjPos.
+     *
+     * @param[in]       startAdjPos  The starting point in the expression evaluation.
+     * @param[in]         endAdjPos  The ending point in the expression evaluation.
+     * @param[in,out]          func  The function object that is called for each statement.
+     * @param[in,out]    primalData  The vector of the primal variables.
+     * @param[in,out]   constantPos  The current position in the constant data vector. It will incremented in the method.
+     * @param[in]       endConstPos  The ending position in the constant data vector.
+     * @param[in]         constants  The constant values in the rhs expressions.
+     * @param[in,out]    passivePos  The current position in the passive data vector. It will incremented in the method.
+     * @param[in]     endPassivePos  The ending position in the passive data vector.
+     * @param[in]          passives  The passive values in the rhs expressions.
+     * @param[in,out]      indexPos  The current position in the index data. It will incremented in the method.
+     * @param[in]       endIndexPos  The ending position in the index data.
+     * @param[in]           indices  The indices for the arguments of the rhs.
+     * @param[in,out]       stmtPos  The current position in the statement data. It will incremented in the method.
+     * @param[in]        endStmtPos  The ending position in the statement data.
+     * @param[in]        statements  The vector with the handles for each statement.
+     * @param[in] passiveActiveReal  The number passive values for each statement.
+     *
+     * @tparam Func  See forEachStatement for the signature.
+     */
+    template<typename Func>
+    static CODI_INLINE void iterateStackForward(const size_t& startAdjPos, const size_t& endAdjPos, Func& func, Real* primalData,
+                                         size_t& constantPos, const size_t& endConstPos, PassiveReal* &constants,
+                                         size_t& passivePos, const size_t& endPassivePos, Real* &passives,
+                                         size_t& indexPos, const size_t& endIndexPos, Index* &indices,
+                                         size_t& stmtPos, const size_t& endStmtPos, Handle* &statements,
+                                         StatementInt* &passiveActiveReal) {
+      CODI_UNUSED(endConstPos);
+      CODI_UNUSED(endPassivePos);
+      CODI_UNUSED(endIndexPos);
+      CODI_UNUSED(endStmtPos);
+
+      Index activeIndices[MaxStatementIntSize];
+
+      size_t adjPos = startAdjPos;
+
+      while(adjPos < endAdjPos) {
+        adjPos += 1;
+
+        if(StatementIntInputTag != passiveActiveReal[stmtPos]) {
+          const size_t argStart = indexPos;
+          HandleFactory::template callPrimalHandle<PrimalValueTape<TapeTypes> >(statements[stmtPos], passiveActiveReal[stmtPos], indexPos, indices, passivePos, passives, constantPos, constants, primalData);
+
+          const size_t nArgs = PrimalValueModule<TapeTypes, PrimalValueTape<TapeTypes>>::getActiveIndices(activeIndices, &indices[argStart], indexPos - argStart, passiveActiveReal[stmtPos]);
+          func((Index)adjPos, nArgs, (const Index*)activeIndices, (const Real*)NULL, HandleFactory::getHandleName(statements[stmtPos]));
+        }
+
+        stmtPos += 1;
+      }
+    }
+
+    WRAP_FUNCTION_TEMPLATE(Wrap_iterateStackForward, iterateStackForward);
+
 
     /**
      * @brief Allocates a copy of the primal vector that is used in the evaluation.
@@ -501,6 +568,10 @@ namespace codi {
       Wrap_evaluateStackReverse<AdjVecType<AdjointData>> evalFunc{};
       auto reverseFunc = &TapeTypes::ConstantValueVector::template evaluateReverse<decltype(evalFunc), Real*&, AdjVecType<AdjointData>*&>;
       this->evaluateExtFunc(start, end, reverseFunc, this->constantValueVector, &interface, evalFunc, this->primals, adjVec);
+
+      // The arguments of the statements have smaller indices than the start position.
+      this->sweepAdjointsBegin = 0;
+      this->sweepAdjointsEnd = start.inner.inner.inner.inner.inner + 1;
     }
 
     /**
@@ -525,6 +596,10 @@ namespace codi {
       Wrap_evaluateStackForward<AdjVecType<AdjointData>> evalFunc{};
       auto forwardFunc = &TapeTypes::ConstantValueVector::template evaluateForward<decltype(evalFunc), Real*&, AdjVecType<AdjointData>*&>;
       this->evaluateExtFuncForward(start, end, forwardFunc, this->constantValueVector, &interface, evalFunc, this->primals, adjVec);
+
+      // Only the lhs values between the positions are written.
+      this->sweepAdjointsBegin = start.inner.inner.inner.inner.inner + 1;
+      this->sweepAdjointsEnd = end.inner.inner.inner.inner.inner + 1;
     }
 
     /**
@@ -623,6 +698,50 @@ namespace codi {
       }
     }
 
+    /**
+     * @brief Call the function object for each statement between the start and the end position.
+     *
+     * The statements are visited in the order of the recording. The function object is called as
+     * \code{.cpp}
+     *   func(lhsIndex, nArgs, indices, jacobies, operation);
+     * \endcode
+     * with the types (const Index&, size_t, const Index*, const Real*, const char*). The primal value tapes do not store
+     * Jacobians, therefore jacobies is always NULL. The operation is the mangled type name of the expression if the
+     * handle factory provides it, otherwise NULL. Only the active arguments are given in indices.
+     *
+     * The primal values of the statements are evaluated in order to determine the arguments. The handle factory needs
+     * to support primal evaluations.
+     *
+     * Input statements and external functions are skipped.
+     *
+     * It has to hold start <= end.
+     *
+     * @param[in]  start  The starting position.
+     * @param[in]    end  The ending position.
+     * @param[in,out] func  The function object that is called for each statement.
+     *
+     * @tparam Func  A function object with the above signature.
+     */
+    template<typename Func>
+    void forEachStatement(const Position& start, const Position& end, Func&& func) {
+      Wrap_iterateStackForward<Func> iterFunc{};
+      this->constantValueVector.evaluateForward(start.inner, end.inner, iterFunc, func, this->primals);
+    }
+
+    /**
+     * @brief Call the function object for each statement of the tape.
+     *
+     * See forEachStatement(const Position&, const Position&, Func&&) for details.
+     *
+     * @param[in,out] func  The function object that is called for each statement.
+     *
+     * @tparam Func  A function object with the signature described in forEachStatement.
+     */
+    template<typename Func>
+    void forEachStatement(Func&& func) {
+      forEachStatement(this->getZeroPosition(), this->getPosition(), std::forward<Func>(func));
+    }
+
     /**
      * @brief Gather the general performance values of the tape.
      *
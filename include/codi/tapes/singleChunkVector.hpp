@@ -34,6 +34,7 @@
 #include "chunk.hpp"
 #include "emptyChunkVector.hpp"
 #include "pointerHandle.hpp"
+#include "../tools/instrumentation.hpp"
 
 /**
  * @brief Global namespace for CoDiPack - Code Differentiation Package
@@ -199,6 +200,24 @@ namespace codi {
 
     }
 
+#if CODI_EnableInstrumentation
+    /**
+     * @brief Add the counters of the nested vectors, the single chunk is never switched.
+     *
+     * @param[in,out] counters  The counters are added to this structure.
+     */
+    void addInstrumentation(Instrumentation& counters) const {
+      nested->addInstrumentation(counters);
+    }
+
+    /**
+     * @brief Set the counters of the nested vectors to zero.
+     */
+    void resetInstrumentation() {
+      nested->resetInstrumentation();
+    }
+#endif
+
     /**
      * @brief Sets the size of the chunk.
      * @param chunkSize   The new chunk size.
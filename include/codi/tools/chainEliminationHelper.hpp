@@ -0,0 +1,213 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../configure.h"
+#include "../exceptions.hpp"
+#include "../typeFunctions.hpp"
+#include "tapeGraph.hpp"
+#include "tapeValues.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Removes copies and chains of single argument statements from the statement graph of a Jacobi tape.
+   *
+   * A statement with one argument \f$ w = d \cdot v \f$ is removed from the graph. The statements that use \f$ w \f$
+   * use \f$ v \f$ instead and their Jacobian is multiplied with \f$ d \f$. Since the statements are processed in the
+   * recorded order, whole chains of single argument statements are folded into one factor. If an argument appears
+   * several times in a statement after the substitution, e.g. for \f$ a = b + c \f$ where \f$ c \f$ is a copy of
+   * \f$ b \f$, the Jacobians are summed up. Arguments with a zero Jacobian are removed. A statement that has only
+   * one argument after these steps is eliminated as well.
+   *
+   * Statements whose lhs is not used by another statement are the outputs of the graph and are always kept. Other
+   * indices which are accessed by the user, e.g. intermediate values that are seeded or read, need to be marked with
+   * keepIndex.
+   *
+   * The result is a new graph which can be recorded on a new tape with the TapeReorderHelper:
+   * \code{.cpp}
+   *   codi::ChainEliminationHelper<codi::RealReverse::TapeType> elimination;
+   *   codi::TapeGraph<codi::RealReverse::TapeType> graph = elimination.eliminate(codi::TapeGraph<codi::RealReverse::TapeType>(tape));
+   *
+   *   codi::TapeReorderHelper<codi::RealReverse::TapeType> reorder(graph);
+   *   reorder.record(newTape);
+   * \endcode
+   *
+   * The elimination requires that each index is written only once in the graph, which is the case for tapes with a
+   * linear index handler.
+   *
+   * @tparam Tape  A Jacobi tape with a linear index handler which implements forEachStatement.
+   */
+  template<typename Tape>
+  struct ChainEliminationHelper {
+
+      typedef typename Tape::Real Real; /**< The floating point calculation type of the tape */
+      typedef typename Tape::Index Index; /**< The index type of the tape */
+
+    private:
+
+      std::unordered_map<Index, bool> keptIndices; /**< The indices that are not eliminated */
+
+      size_t eliminatedStatements; /**< The number of removed statements in the last elimination */
+      size_t mergedArguments; /**< The number of arguments that have been combined with another argument */
+      size_t zeroArguments; /**< The number of arguments that have been removed due to a zero Jacobian */
+
+    public:
+
+      /**
+       * @brief Create a helper without kept indices.
+       */
+      ChainEliminationHelper() :
+        keptIndices(),
+        eliminatedStatements(0),
+        mergedArguments(0),
+        zeroArguments(0) {}
+
+      /**
+       * @brief Mark an index such that the statement which computes it is not eliminated.
+       *
+       * @param[in] index  The index of a value that is seeded or read by the user.
+       */
+      void keepIndex(const Index& index) {
+        keptIndices[index] = true;
+      }
+
+      /**
+       * @brief Create the simplified graph.
+       *
+       * @param[in] graph  The statement graph of a Jacobi tape.
+       *
+       * @return The graph without the eliminated statements.
+       */
+      TapeGraph<Tape> eliminate(const TapeGraph<Tape>& graph) {
+        if(graph.jacobies.size() != graph.argumentIndices.size()) {
+          CODI_EXCEPTION("The chain elimination requires a tape that stores the Jacobians of the statements.");
+        }
+
+        if(!graph.isSingleAssignment()) {
+          CODI_EXCEPTION("The chain elimination requires a tape where each index is written only once.");
+        }
+
+        eliminatedStatements = 0;
+        mergedArguments = 0;
+        zeroArguments = 0;
+
+        std::vector<bool> hasConsumers(graph.getStatementCount(), false);
+        for(size_t arg = 0; arg < graph.argumentStatements.size(); ++arg) {
+          if(TapeGraph<Tape>::InputArgument != graph.argumentStatements[arg]) {
+            hasConsumers[graph.argumentStatements[arg]] = true;
+          }
+        }
+
+        // The replacement for each eliminated lhs, a zero index marks a value with a zero derivative.
+        std::unordered_map<Index, std::pair<Index, Real> > substitutions;
+
+        TapeGraph<Tape> result;
+        Index indices[MaxStatementIntSize];
+        Real jacobies[MaxStatementIntSize];
+
+        for(size_t stmt = 0; stmt < graph.getStatementCount(); ++stmt) {
+          size_t nArgs = 0;
+
+          for(size_t arg = graph.argumentOffsets[stmt]; arg < graph.argumentOffsets[stmt + 1]; ++arg) {
+            Index index = graph.argumentIndices[arg];
+            Real jacobi = graph.jacobies[arg];
+
+            typename std::unordered_map<Index, std::pair<Index, Real> >::const_iterator substitution = substitutions.find(index);
+            if(substitutions.end() != substitution) {
+              index = substitution->second.first;
+              jacobi *= substitution->second.second;
+            }
+
+            if(0 == index) {
+              continue;
+            }
+
+            size_t pos = 0;
+            while(pos < nArgs && indices[pos] != index) {
+              ++pos;
+            }
+
+            if(pos < nArgs) {
+              jacobies[pos] += jacobi;
+              mergedArguments += 1;
+            } else {
+              indices[nArgs] = index;
+              jacobies[nArgs] = jacobi;
+              nArgs += 1;
+            }
+          }
+
+          size_t nonZeroArgs = 0;
+          for(size_t pos = 0; pos < nArgs; ++pos) {
+            if(isTotalZero(jacobies[pos])) {
+              zeroArguments += 1;
+            } else {
+              indices[nonZeroArgs] = indices[pos];
+              jacobies[nonZeroArgs] = jacobies[pos];
+              nonZeroArgs += 1;
+            }
+          }
+
+          const Index lhsIndex = graph.lhsIndices[stmt];
+          if(nonZeroArgs <= 1 && hasConsumers[stmt] && keptIndices.end() == keptIndices.find(lhsIndex)) {
+            if(0 == nonZeroArgs) {
+              substitutions[lhsIndex] = std::make_pair(Index(0), Real());
+            } else {
+              substitutions[lhsIndex] = std::make_pair(indices[0], jacobies[0]);
+            }
+            eliminatedStatements += 1;
+          } else {
+            result.addStatement(lhsIndex, nonZeroArgs, indices, jacobies, NULL);
+          }
+        }
+
+        return result;
+      }
+
+      /**
+       * @brief Add the statistics of the last elimination as a new section to the tape values.
+       *
+       * @param[in,out] values  The information is added to the values.
+       */
+      void addValues(TapeValues& values) const {
+        values.addSection("Chain elimination");
+        values.addData("Eliminated statements", eliminatedStatements);
+        values.addData("Merged arguments", mergedArguments);
+        values.addData("Zero arguments", zeroArguments);
+      }
+  };
+}
@@ -0,0 +1,297 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../configure.h"
+#include "../typeTraits.hpp"
+#include "direction.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Helper for the reverse accumulation of converged fixed point iterations.
+   *
+   * For a fixed point iteration \f$ x = G(x, p) \f$ the derivative of the converged state does not depend on the
+   * iterations that lead to the fixed point. It is therefore sufficient to record only one iteration at the converged
+   * state. In the reverse evaluation the adjoint fixed point iteration
+   * \f[ \bar x_{k+1} = \bar y + \frac{\partial G}{\partial x}^T \bar x_k \f]
+   * is evaluated on this recorded iteration until it is converged. \f$ \bar y \f$ is the adjoint of the state after the
+   * iteration.
+   *
+   * The helper evaluates the increments \f$ \delta_{k+1} = \frac{\partial G}{\partial x}^T \delta_k \f$ with
+   * \f$ \delta_0 = \bar y \f$. Each evaluation of the recorded iteration updates the adjoints of the parameters with
+   * \f$ \frac{\partial G}{\partial p}^T \delta_k \f$, therefore the parameters have the correct adjoint
+   * \f$ \frac{\partial G}{\partial p}^T \bar x \f$ at the end of the iteration.
+   *
+   * The usage is:
+   * \code{.cpp}
+   * FixedPointHelper<CoDiType> fp;
+   *
+   * tape.setPassive();
+   * // iterate the state until it is converged
+   * tape.setActive();
+   *
+   * fp.start(state, n);
+   * // compute one iteration state = G(state, p)
+   * fp.finish(state, n);
+   *
+   * // ... further computations
+   *
+   * // reverse evaluation
+   * tape.evaluate(tape.getPosition(), fp.getEndPosition());
+   * fp.evaluate();
+   * tape.evaluate(fp.getStartPosition(), tape.getZeroPosition());
+   * \endcode
+   *
+   * The dependencies of the state before the iteration are not recorded, the adjoints are only propagated to the
+   * parameters of the iteration.
+   *
+   * Tapes which reset the primal values in the reverse evaluation (Tape::RequiresPrimalReset) need to evaluate on the
+   * primal value vector, e.g. with setUsePrimalCopy(false), otherwise the evaluation by positions uses the wrong primal
+   * values.
+   *
+   * @tparam CoDiType  This needs to be one of the CoDiPack types defined through an ActiveReal.
+   */
+  template<typename CoDiType>
+  struct FixedPointHelper {
+
+      typedef typename CoDiType::Real Real; /**< The floating point calculation type in the CoDiPack types. */
+      typedef typename CoDiType::GradientData GradientData;  /**< The type for the gradient identification */
+      typedef typename CoDiType::GradientValue GradientValue;  /**< The type for the gradient computation */
+
+      typedef typename TypeTraits<Real>::PassiveReal PassiveReal; /**< The passive type of the CoDiPack type. */
+
+      typedef typename CoDiType::TapeType Tape; /**< The type for the tape */
+      typedef typename Tape::Position Position; /**< The type for the position in the tape */
+
+      std::vector<GradientData> inputData; /**< The identifiers of the state before the recorded iteration. */
+      std::vector<GradientData> outputData; /**< The identifiers of the state after the recorded iteration. */
+      Position startPos; /**< The starting point of the recorded iteration. */
+      Position endPos; /**< The end point of the recorded iteration. */
+
+      std::vector<GradientValue> increments; /**< The current increments of the adjoint fixed point iteration. */
+
+    private:
+
+      PassiveReal tolerance; /**< The tolerance for the maximum norm of the increments. */
+      size_t maxIterations; /**< The maximum number of adjoint iterations. */
+
+    public:
+
+      /**
+       * @brief Create a helper with a tolerance of 1e-12 and at most 1000 adjoint iterations.
+       */
+      FixedPointHelper() :
+        inputData(),
+        outputData(),
+        startPos(),
+        endPos(),
+        increments(),
+        tolerance(1e-12),
+        maxIterations(1000) {}
+
+      /**
+       * @brief Set the convergence criterion for the adjoint iteration.
+       *
+       * @param[in] newTolerance  The iteration stops if the maximum norm of the increment is smaller or equal.
+       */
+      void setTolerance(const PassiveReal& newTolerance) {
+        tolerance = newTolerance;
+      }
+
+      /**
+       * @brief Set the maximum number of adjoint iterations.
+       *
+       * @param[in] newMaxIterations  The maximum number of evaluations of the recorded iteration.
+       */
+      void setMaxIterations(size_t newMaxIterations) {
+        maxIterations = newMaxIterations;
+      }
+
+      /**
+       * @brief Start the recording of the iteration at the converged state.
+       *
+       * The state is registered as a new input on the tape.
+       *
+       * @param[in,out] state  The converged state.
+       * @param[in]      size  The size of the state.
+       */
+      void start(CoDiType* state, size_t size) {
+        Tape& tape = CoDiType::getGlobalTape();
+
+        if(tape.isActive()) {
+          inputData.clear();
+
+          startPos = tape.getPosition();
+
+          for(size_t i = 0; i < size; ++i) {
+            tape.registerInput(state[i]);
+            inputData.push_back(state[i].getGradientData());
+          }
+        }
+      }
+
+      /**
+       * @brief Finish the recording of the iteration.
+       *
+       * The state is registered as an output of the iteration.
+       *
+       * @param[in,out] state  The state after the recorded iteration.
+       * @param[in]      size  The size of the state, it has to be the same as in start.
+       */
+      void finish(CoDiType* state, size_t size) {
+        Tape& tape = CoDiType::getGlobalTape();
+
+        if(tape.isActive()) {
+          outputData.clear();
+
+          for(size_t i = 0; i < size; ++i) {
+            tape.registerOutput(state[i]);
+            outputData.push_back(state[i].getGradientData());
+          }
+
+          endPos = tape.getPosition();
+        }
+      }
+
+      /**
+       * @brief The position on the tape before the recorded iteration.
+       *
+       * @return The position from the start call.
+       */
+      const Position& getStartPosition() const {
+        return startPos;
+      }
+
+      /**
+       * @brief The position on the tape after the recorded iteration.
+       *
+       * @return The position from the finish call.
+       */
+      const Position& getEndPosition() const {
+        return endPos;
+      }
+
+      /**
+       * @brief Evaluate the adjoint fixed point iteration.
+       *
+       * The tape has to be evaluated up to the end position of the recorded iteration. Afterwards the adjoints of the
+       * parameters of the iteration are updated and the evaluation can be continued from the start position.
+       *
+       * @return The number of evaluations of the recorded iteration.
+       */
+      size_t evaluate() {
+        Tape& tape = CoDiType::getGlobalTape();
+
+        increments.resize(outputData.size());
+        for(size_t i = 0; i < outputData.size(); ++i) {
+          increments[i] = tape.getGradient(outputData[i]);
+        }
+
+        if(Tape::RequiresPrimalReset) {
+          // the primal values need to be the ones of the end position, the tangents are cleared afterwards
+          tape.evaluateForwardPreacc(startPos, endPos);
+        }
+        tape.clearAdjoints(endPos, startPos);
+
+        size_t iteration = 0;
+        bool converged = false;
+        while(!converged && iteration < maxIterations) {
+          for(size_t i = 0; i < outputData.size(); ++i) {
+            tape.setGradient(outputData[i], increments[i]);
+          }
+
+          tape.evaluatePreacc(endPos, startPos);
+          iteration += 1;
+
+          PassiveReal norm = PassiveReal();
+          for(size_t i = 0; i < inputData.size(); ++i) {
+            increments[i] = tape.getGradient(inputData[i]);
+            tape.setGradient(inputData[i], GradientValue());
+
+            norm = std::max(norm, maxNorm(increments[i]));
+          }
+
+          converged = norm <= tolerance;
+        }
+
+        tape.clearAdjoints(endPos, startPos);
+
+        if(Tape::RequiresPrimalReset) {
+          // reset the primal values to the start position, all adjoints of the iteration are zero
+          tape.evaluate(endPos, startPos);
+        }
+
+        return iteration;
+      }
+
+    private:
+
+      /**
+       * @brief The absolute value of a scalar gradient.
+       *
+       * @param[in] value  The gradient value.
+       * @return The absolute value of the primal base value.
+       *
+       * @tparam T  The type of the gradient value.
+       */
+      template<typename T>
+      static PassiveReal maxNorm(const T& value) {
+        using std::abs;
+
+        return abs(TypeTraits<T>::getBaseValue(value));
+      }
+
+      /**
+       * @brief The maximum norm of a vector gradient.
+       *
+       * @param[in] value  The gradient value.
+       * @return The maximum over the absolute values of all directions.
+       *
+       * @tparam T  The type of the entries in the direction.
+       * @tparam dim  The number of directions.
+       */
+      template<typename T, size_t dim>
+      static PassiveReal maxNorm(const Direction<T, dim>& value) {
+        PassiveReal norm = PassiveReal();
+        for(size_t i = 0; i < dim; ++i) {
+          norm = std::max(norm, maxNorm(value[i]));
+        }
+
+        return norm;
+      }
+  };
+}
@@ -0,0 +1,131 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "../configure.h"
+#include "tapeValues.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Counters for the hot paths of the tapes.
+   *
+   * The counters are only updated if CoDiPack is compiled with CODI_EnableInstrumentation=true. Otherwise no code is
+   * generated for the instrumentation points. Each tape gathers its own counters. The counters of the chunk vectors
+   * and the index handler are stored in these structures and are collected by the tape. The counters are added to
+   * the TapeValues of the tape, i.e. they appear in printStatistics, printTableHeader and printTableRow.
+   *
+   * The counters are not synchronized, a tape that is used by several threads reports undefined values.
+   *
+   * The times are accumulated in nanoseconds and reported in microseconds.
+   */
+  struct Instrumentation {
+
+      /** @brief The clock for the time measurements. */
+      typedef std::chrono::steady_clock Clock;
+
+      size_t chunkSwitches;         /**< Number of new chunks that are started in the chunk vectors. */
+      size_t adjointResizes;        /**< Number of resize operations of the adjoint vectors. */
+      size_t externalFunctionCalls; /**< Number of external function evaluations in all evaluation modes. */
+      size_t externalFunctionTime;  /**< Time in the external function evaluations. */
+      size_t passiveValuePushes;    /**< Number of passive arguments that are stored by the primal value tapes. */
+      size_t indexReuseHits;        /**< Number of created indices that were used before. */
+      size_t indexReuseMisses;      /**< Number of created indices that were not used before. */
+      size_t recordTime;            /**< Time between setActive and setPassive. */
+      size_t evaluateTime;          /**< Time in the reverse and forward evaluations. */
+      size_t clearTime;             /**< Time in the clearing of the adjoint vectors. */
+
+      /**
+       * @brief All counters are zero.
+       */
+      Instrumentation() {
+        reset();
+      }
+
+      /**
+       * @brief Set all counters to zero.
+       */
+      void reset() {
+        chunkSwitches = 0;
+        adjointResizes = 0;
+        externalFunctionCalls = 0;
+        externalFunctionTime = 0;
+        passiveValuePushes = 0;
+        indexReuseHits = 0;
+        indexReuseMisses = 0;
+        recordTime = 0;
+        evaluateTime = 0;
+        clearTime = 0;
+      }
+
+      /**
+       * @brief The current time for a time measurement.
+       *
+       * @return The current time.
+       */
+      static CODI_INLINE Clock::time_point now() {
+        return Clock::now();
+      }
+
+      /**
+       * @brief The time since the start of a measurement.
+       *
+       * @param[in] start  The start of the measurement.
+       *
+       * @return The time in nanoseconds.
+       */
+      static CODI_INLINE size_t elapsed(const Clock::time_point& start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+      }
+
+      /**
+       * @brief Add the counters as a new section to the tape values.
+       *
+       * @param[in,out] values  The information is added to the values.
+       */
+      void addValues(TapeValues& values) const {
+        values.addSection("Instrumentation");
+        values.addData("Chunk switches", chunkSwitches);
+        values.addData("Adjoint resizes", adjointResizes);
+        values.addData("External function calls", externalFunctionCalls);
+        values.addData("External function time [us]", externalFunctionTime / 1000);
+        values.addData("Passive value pushes", passiveValuePushes);
+        values.addData("Index reuse hits", indexReuseHits);
+        values.addData("Index reuse misses", indexReuseMisses);
+        values.addData("Record time [us]", recordTime / 1000);
+        values.addData("Evaluate time [us]", evaluateTime / 1000);
+        values.addData("Clear time [us]", clearTime / 1000);
+      }
+  };
+}
@@ -43,17 +43,58 @@ namespace codi {
    * The sorter buffers the pushed entries for each statement and
    * add Jacobian values for arguments that have the same identifier.
    *
+   * Small statements are searched linearly. If a statement has more than
+   * HashThreshold arguments, the positions of the identifiers are stored in
+   * an open addressing hash table with linear probing. Otherwise the search
+   * would be quadratic in the number of arguments.
+   *
+   * The sorter is only used for expressions which are recorded with CODI_EnableCombineJacobianArguments.
+   * Statements pushed with the StatementPushHelper are stored directly with pushJacobiManual, identifiers that
+   * appear several times are neither combined nor searched.
+   *
    * @tparam         Real  The floating point value used by the tapes.
    * @tparam GradientData  The type of the Jacobian values.
    */
   template<typename Real, typename GradientData>
   struct JacobianSorter {
 
+      /** @brief Number of arguments up to which the identifiers are searched linearly. */
+      static const StatementInt HashThreshold = 16;
+
+      /**
+       * @brief Compute the size of the hash table.
+       *
+       * @param[in] size  The current candidate for the size.
+       *
+       * @return The smallest power of two which is at least twice the maximum number of arguments.
+       */
+      static constexpr size_t computeHashSize(size_t size) {
+        return size >= 2 * MaxStatementIntSize ? size : computeHashSize(2 * size);
+      }
+
+      /** @brief The size of the hash table, the load factor is at most one half. */
+      static const size_t HashSize = computeHashSize(1);
+
       std::array<GradientData, MaxStatementIntSize> indices; /**< Array of the identifiers */
       std::array<Real, MaxStatementIntSize> jacobies; /**< Array of the Jacobian values */
       StatementInt size; /**< Current number of arguments for the expression */
 
-      JacobianSorter() = default; /**< Default constructor */
+    private:
+
+      std::array<StatementInt, HashSize> table; /**< Position + 1 of the identifiers, zero for empty entries */
+      std::array<size_t, MaxStatementIntSize> slots; /**< The entry in the table for each position */
+
+    public:
+
+      /**
+       * @brief Create an empty sorter.
+       */
+      JacobianSorter() :
+        indices(),
+        jacobies(),
+        size(0),
+        table(),
+        slots() {}
 
       /**
        * @brief Wrapper method that buffers the arguments for the statement.
@@ -65,23 +106,26 @@ namespace codi {
        * @param[in]  index  The identifier for the argument.
        */
       CODI_INLINE void setDataAndMove(const Real& jacobi, const GradientData& index) {
-        bool found = false;
-        StatementInt pos;
-        for(pos = 0; pos < size; pos += 1) {
-          if(indices[pos] == index) {
-            found = true;
-            break;
-          }
-        }
+        size_t slot = 0;
+        StatementInt pos = size < HashThreshold ? findLinear(index) : findHashed(index, slot);
 
-        if(!found) {
-          size += 1;
+        if(pos == size) {
           indices[pos] = index;
           jacobies[pos] = jacobi;
+          size += 1;
+
+          if(size > HashThreshold) {
+            insertHashed(pos, slot);
+          } else if(size == HashThreshold) {
+            // switch to the hash table for the following arguments
+            for(StatementInt cur = 0; cur < size; cur += 1) {
+              findHashed(indices[cur], slot);
+              insertHashed(cur, slot);
+            }
+          }
         } else {
           jacobies[pos] += jacobi;
         }
-
       }
 
       /**
@@ -98,7 +142,69 @@ namespace codi {
         }
 
         // Reset the data for the next statement
+        if(size >= HashThreshold) {
+          for(StatementInt pos = 0; pos < size; pos += 1) {
+            table[slots[pos]] = 0;
+          }
+        }
         size = 0;
       }
+
+    private:
+
+      /**
+       * @brief Search the identifier in the buffer.
+       *
+       * @param[in] index  The identifier for the argument.
+       *
+       * @return The position of the identifier or size if it is not in the buffer.
+       */
+      CODI_INLINE StatementInt findLinear(const GradientData& index) const {
+        StatementInt pos;
+        for(pos = 0; pos < size; pos += 1) {
+          if(indices[pos] == index) {
+            break;
+          }
+        }
+
+        return pos;
+      }
+
+      /**
+       * @brief Search the identifier in the hash table.
+       *
+       * @param[in]  index  The identifier for the argument.
+       * @param[out]  slot  The entry of the identifier in the table or the first empty entry.
+       *
+       * @return The position of the identifier or size if it is not in the buffer.
+       */
+      CODI_INLINE StatementInt findHashed(const GradientData& index, size_t& slot) const {
+        slot = (static_cast<size_t>(index) * 2654435761u) & (HashSize - 1);
+        while(0 != table[slot]) {
+          if(indices[table[slot] - 1] == index) {
+            return table[slot] - 1;
+          }
+          slot = (slot + 1) & (HashSize - 1);
+        }
+
+        return size;
+      }
+
+      /**
+       * @brief Store the position in an empty entry of the hash table.
+       *
+       * @param[in]  pos  The position of the identifier in the buffer.
+       * @param[in] slot  The empty entry from findHashed.
+       */
+      CODI_INLINE void insertHashed(StatementInt pos, size_t slot) {
+        table[slot] = pos + 1;
+        slots[pos] = slot;
+      }
   };
+
+  template<typename Real, typename GradientData>
+  const StatementInt JacobianSorter<Real, GradientData>::HashThreshold;
+
+  template<typename Real, typename GradientData>
+  const size_t JacobianSorter<Real, GradientData>::HashSize;
 }
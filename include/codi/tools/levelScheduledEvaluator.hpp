@@ -0,0 +1,291 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "../configure.h"
+#include "../exceptions.hpp"
+#include "tapeGraph.hpp"
+#include "tapeLevelAnalysis.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Parallel reverse evaluation of a recorded Jacobi tape with a level schedule.
+   *
+   * The schedule is computed once from the levels of the TapeLevelAnalysis. The reverse sweep is then rewritten such
+   * that every adjoint is gathered from the statements that use it as an argument:
+   *
+   * \f[ \bar v_i += \sum_{w \text{ uses } v_i} \frac{\d w}{\d v_i} \bar w \f]
+   *
+   * All statements that use an index are on a higher level than the statement that writes the index. The levels are
+   * evaluated from the highest to the lowest one and each entry of a level updates only its own adjoint. Therefore,
+   * the entries of one level can be evaluated in parallel without any synchronization. The inputs of the tape are
+   * gathered in the last level. If the code is compiled with OpenMP, the levels are evaluated with a parallel loop.
+   *
+   * The schedule requires that each index is written only once in the recorded range, which is the case for tapes
+   * with a linear index handler. External functions are not part of the statement graph and are not evaluated.
+   *
+   * \code{.cpp}
+   *   codi::LevelScheduledEvaluator<codi::RealReverse::TapeType> evaluator(tape);
+   *
+   *   std::vector<double> adjoints(evaluator.getAdjointSize());
+   *   adjoints[y.getGradientData()] = 1.0;
+   *   evaluator.evaluate(adjoints.data());
+   * \endcode
+   *
+   * @tparam Tape  A Jacobi tape which implements forEachStatement.
+   */
+  template<typename Tape>
+  struct LevelScheduledEvaluator {
+
+      typedef typename Tape::Real Real; /**< The computation type of the tape */
+      typedef typename Tape::Index Index; /**< The index type of the tape */
+      typedef typename Tape::Position Position; /**< The position type of the tape */
+
+    private:
+
+      std::vector<size_t> levelOffsets; /**< Start of each level in the targets, the levels are stored in reverse order */
+      std::vector<Index> targets; /**< The indices which are updated on each level */
+      std::vector<size_t> consumerOffsets; /**< Start of the consumers of each target */
+      std::vector<Index> consumerIndices; /**< The lhs indices of the statements which use the targets */
+      std::vector<Real> consumerJacobies; /**< The Jacobians of the targets in the consuming statements */
+      std::vector<Index> statementIndices; /**< The lhs indices of all statements, these are reset after the evaluation */
+
+      Index maximumIndex; /**< The largest index in the schedule */
+      size_t minimumParallelWidth; /**< Levels with fewer entries are evaluated serially */
+
+    public:
+
+      /**
+       * @brief Create the schedule for the whole tape.
+       *
+       * @param[in] tape  The recorded tape.
+       */
+      explicit LevelScheduledEvaluator(Tape& tape) :
+        levelOffsets(),
+        targets(),
+        consumerOffsets(),
+        consumerIndices(),
+        consumerJacobies(),
+        statementIndices(),
+        maximumIndex(0),
+        minimumParallelWidth(64) {
+        create(TapeGraph<Tape>(tape));
+      }
+
+      /**
+       * @brief Create the schedule for a range of the tape.
+       *
+       * @param[in]  tape  The recorded tape.
+       * @param[in] start  The start of the range.
+       * @param[in]   end  The end of the range.
+       */
+      LevelScheduledEvaluator(Tape& tape, const Position& start, const Position& end) :
+        levelOffsets(),
+        targets(),
+        consumerOffsets(),
+        consumerIndices(),
+        consumerJacobies(),
+        statementIndices(),
+        maximumIndex(0),
+        minimumParallelWidth(64) {
+        create(TapeGraph<Tape>(tape, start, end));
+      }
+
+      /**
+       * @brief The required size of the adjoint vector for the evaluation.
+       *
+       * @return The largest index in the schedule plus one.
+       */
+      size_t getAdjointSize() const {
+        return (size_t)maximumIndex + 1;
+      }
+
+      /**
+       * @brief The number of levels in the schedule, including the level of the inputs.
+       *
+       * @return The number of levels.
+       */
+      size_t getLevelCount() const {
+        return levelOffsets.size() - 1;
+      }
+
+      /**
+       * @brief Set the minimum number of entries a level needs to be evaluated in parallel.
+       *
+       * @param[in] width  The minimum width of a parallel level.
+       */
+      void setMinimumParallelWidth(const size_t width) {
+        minimumParallelWidth = width;
+      }
+
+      /**
+       * @brief Perform the reverse evaluation with the schedule.
+       *
+       * The result is the same as the one of a reverse evaluation of the tape over the recorded range.
+       *
+       * @param[in,out] adjointData  The vector for the adjoint evaluation. It has to have the size of getAdjointSize().
+       *
+       * @tparam AdjointData  The type needs to provide an add and multiply operation.
+       */
+      template<typename AdjointData>
+      void evaluate(AdjointData* adjointData) const {
+        for(size_t level = 0; level + 1 < levelOffsets.size(); ++level) {
+          const long begin = (long)levelOffsets[level];
+          const long end = (long)levelOffsets[level + 1];
+
+#ifdef _OPENMP
+          #pragma omp parallel for schedule(static) if(end - begin >= (long)minimumParallelWidth)
+#endif
+          for(long pos = begin; pos < end; ++pos) {
+            AdjointData adj = AdjointData();
+            for(size_t cur = consumerOffsets[pos]; cur < consumerOffsets[pos + 1]; ++cur) {
+              adj += adjointData[consumerIndices[cur]] * consumerJacobies[cur];
+            }
+            adjointData[targets[pos]] += adj;
+          }
+        }
+
+        if(ZeroAdjointReverse) {
+          const long size = (long)statementIndices.size();
+
+#ifdef _OPENMP
+          #pragma omp parallel for schedule(static) if(size >= (long)minimumParallelWidth)
+#endif
+          for(long pos = 0; pos < size; ++pos) {
+            adjointData[statementIndices[pos]] = AdjointData();
+          }
+        }
+      }
+
+    private:
+
+      /**
+       * @brief Compute the level schedule and the gathered consumer data from the graph.
+       *
+       * @param[in] graph  The statement graph of the tape range.
+       */
+      void create(const TapeGraph<Tape>& graph) {
+        if(graph.jacobies.size() != graph.argumentIndices.size()) {
+          CODI_EXCEPTION("The level schedule requires a tape that stores the Jacobians of the statements.");
+        }
+
+        if(!graph.isSingleAssignment()) {
+          CODI_EXCEPTION("The level schedule requires a tape where each index is written only once.");
+        }
+
+        const size_t statementCount = graph.getStatementCount();
+        TapeLevelAnalysis<Tape> analysis(graph);
+
+        // Each statement and each input of the graph is one target of the schedule.
+        std::vector<size_t> targetLevels(statementCount);
+        std::vector<Index> targetIndices(graph.lhsIndices);
+        std::vector<size_t> argumentTargets(graph.getArgumentCount());
+        std::unordered_map<Index, size_t> inputTargets;
+
+        for(size_t stmt = 0; stmt < statementCount; ++stmt) {
+          targetLevels[stmt] = analysis.levels[stmt];
+          maximumIndex = std::max(maximumIndex, graph.lhsIndices[stmt]);
+
+          for(size_t arg = graph.argumentOffsets[stmt]; arg < graph.argumentOffsets[stmt + 1]; ++arg) {
+            const size_t source = graph.argumentStatements[arg];
+            if(TapeGraph<Tape>::InputArgument == source) {
+              const Index index = graph.argumentIndices[arg];
+              typename std::unordered_map<Index, size_t>::iterator iter = inputTargets.find(index);
+              if(inputTargets.end() == iter) {
+                iter = inputTargets.insert(std::make_pair(index, targetIndices.size())).first;
+                targetIndices.push_back(index);
+                targetLevels.push_back(0);
+                maximumIndex = std::max(maximumIndex, index);
+              }
+              argumentTargets[arg] = iter->second;
+            } else {
+              argumentTargets[arg] = source;
+            }
+          }
+        }
+
+        // Sort the targets by level in reverse order, targets without consumers are not part of the schedule.
+        std::vector<size_t> consumerCounts(targetIndices.size(), 0);
+        for(size_t arg = 0; arg < argumentTargets.size(); ++arg) {
+          consumerCounts[argumentTargets[arg]] += 1;
+        }
+
+        const size_t levelCount = analysis.criticalPathLength + 1;
+        std::vector<size_t> levelSizes(levelCount, 0);
+        for(size_t target = 0; target < targetIndices.size(); ++target) {
+          if(0 != consumerCounts[target]) {
+            levelSizes[levelCount - 1 - targetLevels[target]] += 1;
+          }
+        }
+
+        levelOffsets.assign(levelCount + 1, 0);
+        for(size_t level = 0; level < levelCount; ++level) {
+          levelOffsets[level + 1] = levelOffsets[level] + levelSizes[level];
+        }
+
+        std::vector<size_t> schedulePositions(targetIndices.size());
+        std::vector<size_t> levelFill(levelOffsets.begin(), levelOffsets.end() - 1);
+        targets.resize(levelOffsets.back());
+        consumerOffsets.assign(targets.size() + 1, 0);
+        for(size_t target = 0; target < targetIndices.size(); ++target) {
+          if(0 != consumerCounts[target]) {
+            const size_t pos = levelFill[levelCount - 1 - targetLevels[target]]++;
+            schedulePositions[target] = pos;
+            targets[pos] = targetIndices[target];
+            consumerOffsets[pos + 1] = consumerCounts[target];
+          }
+        }
+
+        for(size_t pos = 0; pos < targets.size(); ++pos) {
+          consumerOffsets[pos + 1] += consumerOffsets[pos];
+        }
+
+        std::vector<size_t> consumerFill(consumerOffsets.begin(), consumerOffsets.end() - 1);
+        consumerIndices.resize(consumerOffsets.back());
+        consumerJacobies.resize(consumerOffsets.back());
+        for(size_t stmt = 0; stmt < statementCount; ++stmt) {
+          for(size_t arg = graph.argumentOffsets[stmt]; arg < graph.argumentOffsets[stmt + 1]; ++arg) {
+            const size_t cur = consumerFill[schedulePositions[argumentTargets[arg]]]++;
+            consumerIndices[cur] = graph.lhsIndices[stmt];
+            consumerJacobies[cur] = graph.jacobies[arg];
+          }
+        }
+
+        statementIndices = graph.lhsIndices;
+      }
+  };
+}
@@ -0,0 +1,484 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../configure.h"
+#include "../exceptions.hpp"
+#include "../typeTraits.hpp"
+#include "externalFunctionHelper.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Dense linear algebra operations on arrays of CoDiPack types that are recorded as external functions.
+   *
+   * A matrix product with CoDiPack types records one statement for each multiply-add. The operations in this class
+   * evaluate the primal values with passive kernels and record one external function per call. The reverse
+   * evaluation computes the adjoints with the transposed operations.
+   *
+   * All matrices are stored as row major arrays. The available operations are:
+   *  - dot:   \f$ z = x^T y \f$
+   *  - axpy:  \f$ y = \alpha x + y \f$
+   *  - gemv:  \f$ y = A x \f$
+   *  - gemm:  \f$ C = A B \f$
+   *  - solve: \f$ x = A^{-1} b \f$
+   *
+   * The output arrays must not overlap with the input arrays, the only exception is y in axpy. The external functions
+   * are added with the ExternalFunctionHelper, therefore the operations can be used with all reverse tapes and
+   * behave like passive operations if the tape is not recording.
+   *
+   * @tparam CoDiType  This needs to be one of the CoDiPack types defined through an ActiveReal.
+   */
+  template<typename CoDiType>
+  struct LinearAlgebraHelper {
+
+      typedef typename CoDiType::Real Real; /**< The floating point calculation type in the CoDiPack types. */
+
+      /** @brief The external function helper which records the operations. */
+      typedef ExternalFunctionHelper<CoDiType> Helper;
+
+      /**
+       * @brief Compute the dot product \f$ z = x^T y \f$.
+       *
+       * @param[in]      n  The size of x and y.
+       * @param[in]      x  The first vector.
+       * @param[in]      y  The second vector.
+       * @param[out] result  The dot product of x and y.
+       */
+      static void dot(size_t n, const CoDiType* x, const CoDiType* y, CoDiType& result) {
+        Helper eh(true);
+        eh.disableOutputPrimalStore();
+
+        addInputs(eh, x, n);
+        addInputs(eh, y, n);
+
+        Real z = Real();
+        for(size_t i = 0; i < n; ++i) {
+          z += x[i].getValue() * y[i].getValue();
+        }
+
+        result.setValue(z);
+        eh.addOutput(result);
+
+        eh.addUserData(n);
+        eh.addToTape(dotReverse);
+      }
+
+      /**
+       * @brief Compute the update \f$ y = \alpha x + y \f$.
+       *
+       * @param[in]        n  The size of x and y.
+       * @param[in]    alpha  The scaling of x.
+       * @param[in]        x  The vector which is added.
+       * @param[in,out]    y  The vector which is updated.
+       */
+      static void axpy(size_t n, const CoDiType& alpha, const CoDiType* x, CoDiType* y) {
+        Helper eh(true);
+        eh.disableOutputPrimalStore();
+
+        eh.addInput(alpha);
+        addInputs(eh, x, n);
+        addInputs(eh, y, n);
+
+        for(size_t i = 0; i < n; ++i) {
+          y[i].setValue(alpha.getValue() * x[i].getValue() + y[i].getValue());
+          eh.addOutput(y[i]);
+        }
+
+        eh.addUserData(n);
+        eh.addToTape(axpyReverse);
+      }
+
+      /**
+       * @brief Compute the matrix vector product \f$ y = A x \f$.
+       *
+       * @param[in]  m  The number of rows of A.
+       * @param[in]  n  The number of columns of A.
+       * @param[in]  A  The matrix with the size m x n.
+       * @param[in]  x  The vector with the size n.
+       * @param[out] y  The result with the size m.
+       */
+      static void gemv(size_t m, size_t n, const CoDiType* A, const CoDiType* x, CoDiType* y) {
+        Helper eh(true);
+        eh.disableOutputPrimalStore();
+
+        addInputs(eh, A, m * n);
+        addInputs(eh, x, n);
+
+        for(size_t i = 0; i < m; ++i) {
+          Real sum = Real();
+          for(size_t j = 0; j < n; ++j) {
+            sum += A[i * n + j].getValue() * x[j].getValue();
+          }
+
+          y[i].setValue(sum);
+          eh.addOutput(y[i]);
+        }
+
+        eh.addUserData(m);
+        eh.addUserData(n);
+        eh.addToTape(gemvReverse);
+      }
+
+      /**
+       * @brief Compute the matrix matrix product \f$ C = A B \f$.
+       *
+       * @param[in]  m  The number of rows of A and C.
+       * @param[in]  n  The number of columns of B and C.
+       * @param[in]  k  The number of columns of A and rows of B.
+       * @param[in]  A  The matrix with the size m x k.
+       * @param[in]  B  The matrix with the size k x n.
+       * @param[out] C  The result with the size m x n.
+       */
+      static void gemm(size_t m, size_t n, size_t k, const CoDiType* A, const CoDiType* B, CoDiType* C) {
+        Helper eh(true);
+        eh.disableOutputPrimalStore();
+
+        addInputs(eh, A, m * k);
+        addInputs(eh, B, k * n);
+
+        std::vector<Real> values(m * n, Real());
+        for(size_t i = 0; i < m; ++i) {
+          for(size_t l = 0; l < k; ++l) {
+            const Real a = A[i * k + l].getValue();
+            for(size_t j = 0; j < n; ++j) {
+              values[i * n + j] += a * B[l * n + j].getValue();
+            }
+          }
+        }
+
+        for(size_t i = 0; i < m * n; ++i) {
+          C[i].setValue(values[i]);
+          eh.addOutput(C[i]);
+        }
+
+        eh.addUserData(m);
+        eh.addUserData(n);
+        eh.addUserData(k);
+        eh.addToTape(gemmReverse);
+      }
+
+      /**
+       * @brief Solve the linear system \f$ A x = b \f$.
+       *
+       * The system is solved with an LU decomposition with partial pivoting. The decomposition is stored in the
+       * external function and reused for the transposed system in the reverse evaluation. The method is intended for
+       * small dense systems.
+       *
+       * @param[in]  n  The size of the system.
+       * @param[in]  A  The matrix with the size n x n.
+       * @param[in]  b  The right hand side with the size n.
+       * @param[out] x  The solution with the size n.
+       */
+      static void solve(size_t n, const CoDiType* A, const CoDiType* b, CoDiType* x) {
+        Helper eh(true);
+        eh.disableInputPrimalStore();
+
+        addInputs(eh, A, n * n);
+        addInputs(eh, b, n);
+
+        std::vector<Real> lu(n * n);
+        std::vector<size_t> perm(n);
+        for(size_t i = 0; i < n * n; ++i) {
+          lu[i] = A[i].getValue();
+        }
+        luDecompose(n, lu.data(), perm.data());
+
+        std::vector<Real> values(n);
+        for(size_t i = 0; i < n; ++i) {
+          values[i] = b[perm[i]].getValue();
+        }
+        luSolve(n, lu.data(), values.data());
+
+        for(size_t i = 0; i < n; ++i) {
+          x[i].setValue(values[i]);
+          eh.addOutput(x[i]);
+        }
+
+        eh.addUserData(n);
+        eh.addUserData(lu);
+        eh.addUserData(perm);
+        eh.addToTape(solveReverse);
+      }
+
+    private:
+
+      /**
+       * @brief Add all values of the array to the inputs of the external function.
+       *
+       * @param[in,out] eh  The helper for the external function.
+       * @param[in]  values  The input values.
+       * @param[in]    size  The size of the array.
+       */
+      static void addInputs(Helper& eh, const CoDiType* values, size_t size) {
+        for(size_t i = 0; i < size; ++i) {
+          eh.addInput(values[i]);
+        }
+      }
+
+      /**
+       * @brief Compute the LU decomposition with partial pivoting in place.
+       *
+       * Row i of the decomposition corresponds to row perm[i] of the original matrix. The diagonal of L is not
+       * stored.
+       *
+       * @param[in]        n  The size of the matrix.
+       * @param[in,out]   lu  The matrix which is overwritten with the decomposition.
+       * @param[out]    perm  The row permutation.
+       */
+      static void luDecompose(size_t n, Real* lu, size_t* perm) {
+        using std::abs;
+
+        for(size_t i = 0; i < n; ++i) {
+          perm[i] = i;
+        }
+
+        for(size_t k = 0; k < n; ++k) {
+          size_t pivot = k;
+          for(size_t i = k + 1; i < n; ++i) {
+            if(abs(TypeTraits<Real>::getBaseValue(lu[i * n + k])) > abs(TypeTraits<Real>::getBaseValue(lu[pivot * n + k]))) {
+              pivot = i;
+            }
+          }
+
+          if(0.0 == TypeTraits<Real>::getBaseValue(lu[pivot * n + k])) {
+            CODI_EXCEPTION("Singular matrix in the linear system. Column: %d.", (int)k);
+          }
+
+          if(pivot != k) {
+            std::swap(perm[pivot], perm[k]);
+            for(size_t j = 0; j < n; ++j) {
+              std::swap(lu[pivot * n + j], lu[k * n + j]);
+            }
+          }
+
+          for(size_t i = k + 1; i < n; ++i) {
+            lu[i * n + k] /= lu[k * n + k];
+            for(size_t j = k + 1; j < n; ++j) {
+              lu[i * n + j] -= lu[i * n + k] * lu[k * n + j];
+            }
+          }
+        }
+      }
+
+      /**
+       * @brief Solve \f$ L U x = b \f$ in place.
+       *
+       * @param[in]       n  The size of the system.
+       * @param[in]      lu  The decomposition from luDecompose.
+       * @param[in,out] rhs  The permuted right hand side, it is overwritten with the solution.
+       */
+      static void luSolve(size_t n, const Real* lu, Real* rhs) {
+        for(size_t i = 0; i < n; ++i) {
+          for(size_t j = 0; j < i; ++j) {
+            rhs[i] -= lu[i * n + j] * rhs[j];
+          }
+        }
+
+        for(size_t i = n; i > 0; --i) {
+          for(size_t j = i; j < n; ++j) {
+            rhs[i - 1] -= lu[(i - 1) * n + j] * rhs[j];
+          }
+          rhs[i - 1] /= lu[(i - 1) * n + (i - 1)];
+        }
+      }
+
+      /**
+       * @brief Solve \f$ U^T L^T x = b \f$ in place.
+       *
+       * @param[in]       n  The size of the system.
+       * @param[in]      lu  The decomposition from luDecompose.
+       * @param[in,out] rhs  The right hand side, it is overwritten with the permuted solution.
+       */
+      static void luSolveTransposed(size_t n, const Real* lu, Real* rhs) {
+        for(size_t i = 0; i < n; ++i) {
+          for(size_t j = 0; j < i; ++j) {
+            rhs[i] -= lu[j * n + i] * rhs[j];
+          }
+          rhs[i] /= lu[i * n + i];
+        }
+
+        for(size_t i = n; i > 0; --i) {
+          for(size_t j = i; j < n; ++j) {
+            rhs[i - 1] -= lu[j * n + (i - 1)] * rhs[j];
+          }
+        }
+      }
+
+      /**
+       * @brief Reverse evaluation of dot.
+       *
+       * \f$ \bar x = y \bar z \f$ and \f$ \bar y = x \bar z \f$
+       */
+      static void dotReverse(const Real* x, Real* x_b, size_t m, const Real* y, const Real* y_b, size_t n, DataStore* d) {
+        CODI_UNUSED(m);
+        CODI_UNUSED(n);
+        CODI_UNUSED(y);
+
+        size_t size;
+        d->getData(size);
+
+        for(size_t i = 0; i < size; ++i) {
+          x_b[i] = x[size + i] * y_b[0];
+          x_b[size + i] = x[i] * y_b[0];
+        }
+      }
+
+      /**
+       * @brief Reverse evaluation of axpy.
+       *
+       * \f$ \bar \alpha = x^T \bar y \f$ and \f$ \bar x = \alpha \bar y \f$. The adjoint of y is passed through.
+       */
+      static void axpyReverse(const Real* x, Real* x_b, size_t m, const Real* y, const Real* y_b, size_t n, DataStore* d) {
+        CODI_UNUSED(m);
+        CODI_UNUSED(n);
+        CODI_UNUSED(y);
+
+        size_t size;
+        d->getData(size);
+
+        const Real* xValues = &x[1];
+
+        x_b[0] = Real();
+        for(size_t i = 0; i < size; ++i) {
+          x_b[0] += xValues[i] * y_b[i];
+          x_b[1 + i] = x[0] * y_b[i];
+          x_b[1 + size + i] = y_b[i];
+        }
+      }
+
+      /**
+       * @brief Reverse evaluation of gemv.
+       *
+       * \f$ \bar A = \bar y x^T \f$ and \f$ \bar x = A^T \bar y \f$
+       */
+      static void gemvReverse(const Real* x, Real* x_b, size_t m, const Real* y, const Real* y_b, size_t n, DataStore* d) {
+        CODI_UNUSED(m);
+        CODI_UNUSED(n);
+        CODI_UNUSED(y);
+
+        size_t rows;
+        size_t cols;
+        d->getData(rows);
+        d->getData(cols);
+
+        const Real* A = x;
+        const Real* xValues = &x[rows * cols];
+        Real* A_b = x_b;
+        Real* xValues_b = &x_b[rows * cols];
+
+        for(size_t j = 0; j < cols; ++j) {
+          xValues_b[j] = Real();
+        }
+
+        for(size_t i = 0; i < rows; ++i) {
+          for(size_t j = 0; j < cols; ++j) {
+            A_b[i * cols + j] = y_b[i] * xValues[j];
+            xValues_b[j] += A[i * cols + j] * y_b[i];
+          }
+        }
+      }
+
+      /**
+       * @brief Reverse evaluation of gemm.
+       *
+       * \f$ \bar A = \bar C B^T \f$ and \f$ \bar B = A^T \bar C \f$
+       */
+      static void gemmReverse(const Real* x, Real* x_b, size_t m, const Real* y, const Real* y_b, size_t n, DataStore* d) {
+        CODI_UNUSED(m);
+        CODI_UNUSED(n);
+        CODI_UNUSED(y);
+
+        size_t rows;
+        size_t cols;
+        size_t inner;
+        d->getData(rows);
+        d->getData(cols);
+        d->getData(inner);
+
+        const Real* A = x;
+        const Real* B = &x[rows * inner];
+        Real* A_b = x_b;
+        Real* B_b = &x_b[rows * inner];
+
+        for(size_t i = 0; i < inner * cols; ++i) {
+          B_b[i] = Real();
+        }
+
+        for(size_t i = 0; i < rows; ++i) {
+          for(size_t l = 0; l < inner; ++l) {
+            Real sum = Real();
+            for(size_t j = 0; j < cols; ++j) {
+              sum += y_b[i * cols + j] * B[l * cols + j];
+              B_b[l * cols + j] += A[i * inner + l] * y_b[i * cols + j];
+            }
+            A_b[i * inner + l] = sum;
+          }
+        }
+      }
+
+      /**
+       * @brief Reverse evaluation of solve.
+       *
+       * The transposed system \f$ A^T \bar b = \bar x \f$ is solved with the stored decomposition and the adjoint of
+       * the matrix is \f$ \bar A = -\bar b x^T \f$.
+       */
+      static void solveReverse(const Real* x, Real* x_b, size_t m, const Real* y, const Real* y_b, size_t n, DataStore* d) {
+        CODI_UNUSED(x);
+        CODI_UNUSED(m);
+
+        size_t size;
+        d->getData(size);
+        const std::vector<Real>& lu = d->getData<std::vector<Real> >();
+        const std::vector<size_t>& perm = d->getData<std::vector<size_t> >();
+
+        std::vector<Real> rhs(y_b, y_b + n);
+        luSolveTransposed(size, lu.data(), rhs.data());
+
+        Real* A_b = x_b;
+        Real* b_b = &x_b[size * size];
+        for(size_t i = 0; i < size; ++i) {
+          b_b[perm[i]] = rhs[i];
+        }
+
+        for(size_t i = 0; i < size; ++i) {
+          for(size_t j = 0; j < size; ++j) {
+            A_b[i * size + j] = -b_b[i] * y[j];
+          }
+        }
+      }
+  };
+}
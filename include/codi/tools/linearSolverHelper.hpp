@@ -0,0 +1,198 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "../configure.h"
+#include "externalFunctionHelper.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Helper class for the differentiation of a linear system solve \f$ A x = b \f$.
+   *
+   * Recording an iterative linear solver with CoDiPack types stores every iteration on the tape. This helper calls a
+   * user provided solver on the primal values instead and records only one external function with the entries of
+   * \f$ A \f$ and \f$ b \f$ as inputs. In the reverse evaluation the transposed system
+   * \f[ A^T \bar b = \bar x \f]
+   * is solved with a user provided solver and the adjoint of the matrix is computed with
+   * \f[ \bar A_{ij} = -\bar b_i x_j \f]
+   * for all nonzero entries of \f$ A \f$.
+   *
+   * The matrix is given in coordinate format. Entry k has the row rowIndices[k], the column colIndices[k] and the
+   * value values[k]. Both solvers have the layout defined by LinearSolverHelper::SolveFunc which is
+   *
+   * solve(n, nnz, rowIndices, colIndices, values, rhs, sol, d)
+   *
+   * The primal solver solves \f$ A\,\mathrm{sol} = \mathrm{rhs} \f$ and the transposed solver
+   * \f$ A^T \mathrm{sol} = \mathrm{rhs} \f$. 'd' is the DataStore of the external function. The primal solver can add
+   * data to it, e.g. a factorization of the matrix, which can then be read by the transposed solver. If the transposed
+   * solver only uses such data, the storing of the matrix values can be disabled with disableMatrixStore. The values
+   * pointer for the transposed solver is then a null pointer.
+   *
+   * The usage is:
+   * \code{.cpp}
+   * LinearSolverHelper<CoDiType> lh(solve, solveTransposed);
+   *
+   * lh.solve(n, nnz, rowIndices, colIndices, values, b, x);
+   * \endcode
+   *
+   * @tparam CoDiType  This needs to be one of the CoDiPack types defined through an ActiveReal.
+   */
+  template<typename CoDiType>
+  class LinearSolverHelper {
+    public:
+
+      typedef typename CoDiType::Real Real; /**< The floating point calculation type in the CoDiPack types. */
+
+      /**
+       * @brief The function for the solution of the linear system or the transposed linear system.
+       */
+      typedef void (*SolveFunc)(size_t n, size_t nnz, const int* rowIndices, const int* colIndices, const Real* values, const Real* rhs, Real* sol, DataStore* d);
+
+    private:
+
+      /**
+       * @brief The structure of the linear system that is stored in the external function.
+       */
+      struct SystemData {
+        std::vector<int> rowIndices; /**< The row of each matrix entry. */
+        std::vector<int> colIndices; /**< The column of each matrix entry. */
+        SolveFunc solveTransposedFunc; /**< The solver for the transposed system. */
+        bool storeMatrix; /**< If the values of the matrix are available in the reverse evaluation. */
+      };
+
+      SolveFunc solveFunc; /**< The solver for the linear system. */
+      SolveFunc solveTransposedFunc; /**< The solver for the transposed linear system. */
+
+      bool storeMatrix; /**< If false, the matrix values are not stored for the reverse evaluation. */
+
+    public:
+
+      /**
+       * @brief Create a helper with the solvers for the linear system.
+       *
+       * @param[in]           solveFunc  The solver for the linear system.
+       * @param[in] solveTransposedFunc  The solver for the transposed linear system.
+       */
+      LinearSolverHelper(SolveFunc solveFunc, SolveFunc solveTransposedFunc) :
+        solveFunc(solveFunc),
+        solveTransposedFunc(solveTransposedFunc),
+        storeMatrix(true) {}
+
+      /**
+       * @brief Disables the storing of the matrix values for the reverse evaluation.
+       *
+       * The transposed solver needs to use the data that the primal solver added to the data store.
+       */
+      void disableMatrixStore() {
+        storeMatrix = false;
+      }
+
+      /**
+       * @brief Solve the linear system \f$ A x = b \f$ and record the external function for it.
+       *
+       * @param[in]          n  The size of the system.
+       * @param[in]        nnz  The number of entries in the matrix.
+       * @param[in] rowIndices  The row of each matrix entry.
+       * @param[in] colIndices  The column of each matrix entry.
+       * @param[in]     values  The values of the matrix entries.
+       * @param[in]          b  The right hand side with the size n.
+       * @param[out]         x  The solution with the size n. It must not overlap with b.
+       */
+      void solve(size_t n, size_t nnz, const int* rowIndices, const int* colIndices, const CoDiType* values, const CoDiType* b, CoDiType* x) {
+        ExternalFunctionHelper<CoDiType> eh(true);
+        if(!storeMatrix) {
+          eh.disableInputPrimalStore();
+        }
+
+        std::vector<Real> valuesPrimal(nnz);
+        for(size_t k = 0; k < nnz; ++k) {
+          eh.addInput(values[k]);
+          valuesPrimal[k] = values[k].getValue();
+        }
+
+        std::vector<Real> rhs(n);
+        for(size_t i = 0; i < n; ++i) {
+          eh.addInput(b[i]);
+          rhs[i] = b[i].getValue();
+        }
+
+        SystemData system;
+        system.rowIndices.assign(rowIndices, rowIndices + nnz);
+        system.colIndices.assign(colIndices, colIndices + nnz);
+        system.solveTransposedFunc = solveTransposedFunc;
+        system.storeMatrix = storeMatrix;
+
+        // the system data is read first in the reverse evaluation, the data of the solver follows
+        eh.addUserData(system);
+
+        std::vector<Real> sol(n);
+        solveFunc(n, nnz, rowIndices, colIndices, valuesPrimal.data(), rhs.data(), sol.data(), &eh.getDataStore());
+
+        for(size_t i = 0; i < n; ++i) {
+          x[i].setValue(sol[i]);
+          eh.addOutput(x[i]);
+        }
+
+        eh.addToTape(solveReverse);
+      }
+
+    private:
+
+      /**
+       * @brief Reverse evaluation of the linear system.
+       *
+       * \f$ A^T \bar b = \bar x \f$ and \f$ \bar A_{ij} = -\bar b_i x_j \f$
+       */
+      static void solveReverse(const Real* x, Real* x_b, size_t m, const Real* y, const Real* y_b, size_t n, DataStore* d) {
+        CODI_UNUSED(m);
+
+        const SystemData& system = d->getData<SystemData>();
+        const size_t nnz = system.rowIndices.size();
+
+        const Real* values = nullptr;
+        if(system.storeMatrix) {
+          values = x;
+        }
+
+        Real* values_b = x_b;
+        Real* b_b = &x_b[nnz];
+        system.solveTransposedFunc(n, nnz, system.rowIndices.data(), system.colIndices.data(), values, y_b, b_b, d);
+
+        for(size_t k = 0; k < nnz; ++k) {
+          values_b[k] = -b_b[system.rowIndices[k]] * y[system.colIndices[k]];
+        }
+      }
+  };
+}
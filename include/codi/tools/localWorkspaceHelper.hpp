@@ -0,0 +1,226 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "../configure.h"
+#include "../exceptions.hpp"
+#include "../typeFunctions.hpp"
+#include "direction.hpp"
+#include "tapeGraph.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Computes the Jacobian of a statement graph with vector sweeps over a local workspace.
+   *
+   * Every input and every statement of the graph is assigned to a slot in a local workspace, the arguments of the
+   * statements are translated to these slots once. The Jacobian is then computed with forward or reverse sweeps over
+   * the graph, whichever requires fewer sweeps. Each sweep evaluates PreaccumulationVectorSize directions at once with
+   * a Direction valued workspace. The workspace has only the size of the graph and does not touch the adjoint vector
+   * of the tape.
+   *
+   * \code{.cpp}
+   *   codi::LocalWorkspaceHelper<codi::RealReverse::TapeType> workspace;
+   *   workspace.computeJacobian(graph, inputIndices, nInputs, outputIndices, nOutputs, jacobian);
+   * \endcode
+   *
+   * @tparam Tape  A Jacobi tape which implements forEachStatement.
+   */
+  template<typename Tape>
+  struct LocalWorkspaceHelper {
+
+      typedef typename Tape::Real Real; /**< The floating point calculation type of the tape */
+      typedef typename Tape::Index Index; /**< The index type of the tape */
+
+      /** @brief The vector type of the workspace. */
+      typedef Direction<Real, PreaccumulationVectorSize> Vector;
+
+    private:
+
+      /** @brief Slot for values that are not inputs of the graph. */
+      static const size_t PassiveSlot = std::numeric_limits<size_t>::max();
+
+      std::vector<size_t> argumentSlots; /**< The workspace slot of each argument of the graph */
+      std::vector<size_t> inputSlots; /**< The workspace slot of each input */
+      std::vector<size_t> outputSlots; /**< The workspace slot of each output */
+      std::vector<Vector> workspace; /**< The local workspace for the sweeps */
+
+    public:
+
+      /**
+       * @brief Create an empty helper.
+       */
+      LocalWorkspaceHelper() :
+        argumentSlots(),
+        inputSlots(),
+        outputSlots(),
+        workspace() {}
+
+      /**
+       * @brief Compute the Jacobian of the outputs with respect to the inputs.
+       *
+       * An output is the value of the last statement in the graph that writes the output index. If no statement
+       * writes the index, the derivative is the identity if the output is also an input. Arguments of the graph that
+       * are not in the list of the inputs are treated as passive values.
+       *
+       * @param[in]    graph  The statement graph of a Jacobi tape.
+       * @param[in]   inputs  The indices of the inputs.
+       * @param[in]      nIn  The number of inputs.
+       * @param[in]  outputs  The indices of the outputs.
+       * @param[in]     nOut  The number of outputs.
+       * @param[out] jacobie  The Jacobian, the entry for input i and output j is stored at i + j * nIn.
+       */
+      void computeJacobian(const TapeGraph<Tape>& graph, const Index* inputs, size_t nIn, const Index* outputs,
+                           size_t nOut, Real* jacobie) {
+        if(graph.jacobies.size() != graph.argumentIndices.size()) {
+          CODI_EXCEPTION("The local workspace requires a tape that stores the Jacobians of the statements.");
+        }
+
+        createSlots(graph, inputs, nIn, outputs, nOut);
+
+        const size_t statementCount = graph.getStatementCount();
+        workspace.resize(nIn + statementCount);
+
+        if(nIn < nOut) {
+          for(size_t blockStart = 0; blockStart < nIn; blockStart += PreaccumulationVectorSize) {
+            const size_t blockSize = std::min(PreaccumulationVectorSize, nIn - blockStart);
+
+            std::fill(workspace.begin(), workspace.end(), Vector());
+            for(size_t dir = 0; dir < blockSize; ++dir) {
+              workspace[inputSlots[blockStart + dir]][dir] = 1.0;
+            }
+
+            for(size_t stmt = 0; stmt < statementCount; ++stmt) {
+              Vector tangent = Vector();
+              for(size_t arg = graph.argumentOffsets[stmt]; arg < graph.argumentOffsets[stmt + 1]; ++arg) {
+                if(PassiveSlot != argumentSlots[arg]) {
+                  tangent += graph.jacobies[arg] * workspace[argumentSlots[arg]];
+                }
+              }
+              workspace[nIn + stmt] = tangent;
+            }
+
+            for(size_t out = 0; out < nOut; ++out) {
+              for(size_t dir = 0; dir < blockSize; ++dir) {
+                jacobie[blockStart + dir + out * nIn] = PassiveSlot == outputSlots[out] ? Real() : workspace[outputSlots[out]][dir];
+              }
+            }
+          }
+        } else {
+          for(size_t blockStart = 0; blockStart < nOut; blockStart += PreaccumulationVectorSize) {
+            const size_t blockSize = std::min(PreaccumulationVectorSize, nOut - blockStart);
+
+            std::fill(workspace.begin(), workspace.end(), Vector());
+            for(size_t dir = 0; dir < blockSize; ++dir) {
+              if(PassiveSlot != outputSlots[blockStart + dir]) {
+                workspace[outputSlots[blockStart + dir]][dir] += 1.0;
+              }
+            }
+
+            for(size_t stmt = statementCount; stmt > 0; --stmt) {
+              const Vector adj = workspace[nIn + stmt - 1];
+              if(!isTotalZero(adj)) {
+                for(size_t arg = graph.argumentOffsets[stmt - 1]; arg < graph.argumentOffsets[stmt]; ++arg) {
+                  if(PassiveSlot != argumentSlots[arg]) {
+                    workspace[argumentSlots[arg]] += graph.jacobies[arg] * adj;
+                  }
+                }
+              }
+            }
+
+            for(size_t dir = 0; dir < blockSize; ++dir) {
+              for(size_t in = 0; in < nIn; ++in) {
+                jacobie[in + (blockStart + dir) * nIn] = workspace[inputSlots[in]][dir];
+              }
+            }
+          }
+        }
+      }
+
+    private:
+
+      /**
+       * @brief Assign the workspace slots to the inputs, the arguments and the outputs.
+       *
+       * The inputs use the first nIn slots, the statements use the slots after the inputs in the recorded order. An
+       * input that appears several times uses the slot of its first appearance.
+       *
+       * @param[in]   graph  The statement graph of a Jacobi tape.
+       * @param[in]  inputs  The indices of the inputs.
+       * @param[in]     nIn  The number of inputs.
+       * @param[in] outputs  The indices of the outputs.
+       * @param[in]    nOut  The number of outputs.
+       */
+      void createSlots(const TapeGraph<Tape>& graph, const Index* inputs, size_t nIn, const Index* outputs, size_t nOut) {
+        std::unordered_map<Index, size_t> inputMap;
+        inputSlots.resize(nIn);
+        for(size_t in = 0; in < nIn; ++in) {
+          inputSlots[in] = inputMap.insert(std::make_pair(inputs[in], in)).first->second;
+        }
+
+        argumentSlots.resize(graph.getArgumentCount());
+        for(size_t arg = 0; arg < graph.getArgumentCount(); ++arg) {
+          const size_t source = graph.argumentStatements[arg];
+          if(TapeGraph<Tape>::InputArgument != source) {
+            argumentSlots[arg] = nIn + source;
+          } else {
+            typename std::unordered_map<Index, size_t>::const_iterator input = inputMap.find(graph.argumentIndices[arg]);
+            argumentSlots[arg] = inputMap.end() == input ? PassiveSlot : input->second;
+          }
+        }
+
+        std::unordered_map<Index, size_t> lastWriter;
+        for(size_t stmt = 0; stmt < graph.getStatementCount(); ++stmt) {
+          lastWriter[graph.lhsIndices[stmt]] = stmt;
+        }
+
+        outputSlots.resize(nOut);
+        for(size_t out = 0; out < nOut; ++out) {
+          typename std::unordered_map<Index, size_t>::const_iterator writer = lastWriter.find(outputs[out]);
+          if(lastWriter.end() != writer) {
+            outputSlots[out] = nIn + writer->second;
+          } else {
+            typename std::unordered_map<Index, size_t>::const_iterator input = inputMap.find(outputs[out]);
+            outputSlots[out] = inputMap.end() == input ? PassiveSlot : input->second;
+          }
+        }
+      }
+  };
+
+  template<typename Tape>
+  const size_t LocalWorkspaceHelper<Tape>::PassiveSlot;
+}
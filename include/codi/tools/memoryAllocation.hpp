@@ -0,0 +1,383 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <sys/mman.h>
+  #include <unistd.h>
+  #define CODI_HasMMap 1
+#else
+  #define CODI_HasMMap 0
+#endif
+
+#include "../configure.h"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Allocation policy for the large data arrays of the tapes.
+   *
+   * The chunks of the data vectors and the adjoint vector of the reverse tapes request their memory through this
+   * structure. If huge pages are disabled (the default) the plain new/delete and malloc/realloc/free calls are used.
+   *
+   * If CODI_UseHugePages is enabled, all allocations of at least HugePageThreshold bytes are mapped directly with mmap
+   * and rounded up to a multiple of HugePageSize. On Linux the mapping is advised for transparent huge pages. If
+   * CODI_UseExplicitHugePages is also enabled, a mapping from the reserved huge page pool (MAP_HUGETLB) is tried first.
+   * Every step falls back to the next one if it is not available on the system. On systems without mmap the policy is
+   * always the default one.
+   *
+   * For the adjoint vector the address space can also be reserved up front (see CODI_AdjointReserveSize). The vector
+   * then grows by committing new pages with reserve, commit and release and keeps its address.
+   *
+   * The memory returned by mmap is placed on the NUMA node of the thread that touches it first. The chunk data is
+   * touched by the recording thread. For the adjoint vector see CODI_NumaFirstTouch.
+   */
+  struct MemoryAllocation {
+
+      /**
+       * @brief Check if an allocation of the given size is mapped with huge page support.
+       *
+       * The decision depends only on the size, therefore allocate, reallocate and free agree on it.
+       *
+       * @param[in] bytes  The size of the allocation in bytes.
+       *
+       * @return true if the allocation is mapped.
+       */
+      static CODI_INLINE bool isMapped(const size_t bytes) {
+        return CODI_HasMMap && UseHugePages && HugePageThreshold <= bytes;
+      }
+
+      /**
+       * @brief Allocate raw memory.
+       *
+       * @param[in] bytes  The size of the allocation in bytes.
+       *
+       * @return The pointer to the new memory. Throws std::bad_alloc if no memory is available.
+       */
+      static void* allocate(const size_t bytes) {
+        void* ptr;
+        if(isMapped(bytes)) {
+          ptr = mapMemory(bytes);
+        } else {
+          ptr = malloc(bytes);
+        }
+
+        if(NULL == ptr && 0 != bytes) {
+          throw std::bad_alloc();
+        }
+
+        return ptr;
+      }
+
+      /**
+       * @brief Change the size of an allocation. The old content is preserved up to the smaller of both sizes.
+       *
+       * @param[in,out]      ptr  The memory from a call to allocate or reallocate. Can be NULL if oldBytes is zero.
+       * @param[in]     oldBytes  The size that was used for the allocation of ptr.
+       * @param[in]     newBytes  The new size of the allocation.
+       *
+       * @return The pointer to the resized memory. Throws std::bad_alloc if no memory is available.
+       */
+      static void* reallocate(void* ptr, const size_t oldBytes, const size_t newBytes) {
+        if(NULL == ptr) {
+          return allocate(newBytes);
+        }
+
+        if(!isMapped(oldBytes) && !isMapped(newBytes)) {
+          void* newPtr = realloc(ptr, newBytes);
+          if(NULL == newPtr && 0 != newBytes) {
+            throw std::bad_alloc();
+          }
+          return newPtr;
+        }
+
+        if(isMapped(oldBytes) && isMapped(newBytes) && mappedSize(oldBytes) == mappedSize(newBytes)) {
+          return ptr;
+        }
+
+        void* newPtr = allocate(newBytes);
+        memcpy(newPtr, ptr, oldBytes < newBytes ? oldBytes : newBytes);
+        free(ptr, oldBytes);
+
+        return newPtr;
+      }
+
+      /**
+       * @brief Release memory from allocate or reallocate.
+       *
+       * @param[in,out]   ptr  The memory that is released. Can be NULL.
+       * @param[in]     bytes  The size that was used for the allocation of ptr.
+       */
+      static void free(void* ptr, const size_t bytes) {
+        if(NULL == ptr) {
+          return;
+        }
+
+        if(isMapped(bytes)) {
+          unmapMemory(ptr, bytes);
+        } else {
+          ::free(ptr);
+        }
+      }
+
+      /**
+       * @brief Allocate an array and default initialize all entries.
+       *
+       * Equivalent to new Data[size] if huge pages are disabled.
+       *
+       * @param[in] size  The number of entries.
+       *
+       * @return The new array.
+       *
+       * @tparam Data  The type of the array entries.
+       */
+      template<typename Data>
+      static Data* allocateArray(const size_t size) {
+        if(!isMapped(sizeof(Data) * size)) {
+          return new Data[size];
+        } else {
+          Data* data = (Data*)allocate(sizeof(Data) * size);
+          for(size_t i = 0; i < size; ++i) {
+            new (data + i) Data;
+          }
+
+          return data;
+        }
+      }
+
+      /**
+       * @brief Destroy all entries of an array from allocateArray and release the memory.
+       *
+       * @param[in,out] data  The array that is released.
+       * @param[in]     size  The number of entries that was used for the allocation.
+       *
+       * @tparam Data  The type of the array entries.
+       */
+      template<typename Data>
+      static void freeArray(Data* data, const size_t size) {
+        if(!isMapped(sizeof(Data) * size)) {
+          delete [] data;
+        } else {
+          for(size_t i = 0; i < size; ++i) {
+            data[i].~Data();
+          }
+          free((void*)data, sizeof(Data) * size);
+        }
+      }
+
+      /**
+       * @brief Value initialize the entries [start, end) of an array.
+       *
+       * If CODI_NumaFirstTouch is enabled and OpenMP is available, the entries are initialized in a parallel loop with
+       * a static schedule. The memory is then distributed over the NUMA nodes of the threads like a static parallel
+       * loop over the array accesses it.
+       *
+       * @param[in,out] data  The array that is initialized.
+       * @param[in]    start  The first entry that is initialized.
+       * @param[in]      end  The entry after the last one that is initialized.
+       *
+       * @tparam Data  The type of the array entries.
+       */
+      template<typename Data>
+      static void constructArray(Data* data, const size_t start, const size_t end) {
+#ifdef _OPENMP
+        if(NumaFirstTouch) {
+          const long first = (long)start;
+          const long last = (long)end;
+          #pragma omp parallel for schedule(static)
+          for(long i = first; i < last; ++i) {
+            new (data + i) Data();
+          }
+
+          return;
+        }
+#endif
+        for(size_t i = start; i < end; ++i) {
+          new (data + i) Data();
+        }
+      }
+
+      /**
+       * @brief Reserve address space without committing memory.
+       *
+       * The pages of the reservation are not accessible until they are committed with commit.
+       * On Linux the reservation is advised for transparent huge pages if CODI_UseHugePages is set.
+       *
+       * @param[in] bytes  The size of the reservation in bytes.
+       *
+       * @return The start of the reservation. Throws std::bad_alloc if the address space is not available.
+       */
+      static void* reserve(const size_t bytes) {
+#if CODI_HasMMap
+        const size_t length = pageSize(bytes);
+        void* ptr = mmap(NULL, length, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if(MAP_FAILED == ptr) {
+          throw std::bad_alloc();
+        }
+
+  #ifdef MADV_HUGEPAGE
+        if(UseHugePages) {
+          madvise(ptr, length, MADV_HUGEPAGE);
+        }
+  #endif
+
+        return ptr;
+#else
+        CODI_UNUSED(bytes);
+        throw std::bad_alloc();
+#endif
+      }
+
+      /**
+       * @brief Make the range [0, newBytes) of a reservation accessible.
+       *
+       * Only the pages after oldBytes are touched, the committed memory is zero initialized by the system.
+       *
+       * @param[in,out]      ptr  The start of the reservation.
+       * @param[in]     oldBytes  The size that is already committed.
+       * @param[in]     newBytes  The size that needs to be committed. Needs to be smaller than the reservation.
+       */
+      static void commit(void* ptr, const size_t oldBytes, const size_t newBytes) {
+#if CODI_HasMMap
+        const size_t start = pageSize(oldBytes);
+        const size_t end = pageSize(newBytes);
+        if(start < end) {
+          if(0 != mprotect((char*)ptr + start, end - start, PROT_READ | PROT_WRITE)) {
+            throw std::bad_alloc();
+          }
+        }
+#else
+        CODI_UNUSED(ptr);
+        CODI_UNUSED(oldBytes);
+        CODI_UNUSED(newBytes);
+#endif
+      }
+
+      /**
+       * @brief Release a reservation from reserve.
+       *
+       * @param[in,out]   ptr  The start of the reservation.
+       * @param[in]     bytes  The size that was used for the reservation.
+       */
+      static void release(void* ptr, const size_t bytes) {
+#if CODI_HasMMap
+        munmap(ptr, pageSize(bytes));
+#else
+        CODI_UNUSED(ptr);
+        CODI_UNUSED(bytes);
+#endif
+      }
+
+    private:
+
+#if CODI_HasMMap
+      /**
+       * @brief Round up to a multiple of the system page size.
+       *
+       * @param[in] bytes  The size in bytes.
+       *
+       * @return bytes rounded up to a multiple of the page size.
+       */
+      static CODI_INLINE size_t pageSize(const size_t bytes) {
+        static const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        return ((bytes + page - 1) / page) * page;
+      }
+#endif
+
+      /**
+       * @brief The size of the mapping for an allocation.
+       *
+       * @param[in] bytes  The size of the allocation in bytes.
+       *
+       * @return bytes rounded up to a multiple of HugePageSize.
+       */
+      static CODI_INLINE size_t mappedSize(const size_t bytes) {
+        return ((bytes + HugePageSize - 1) / HugePageSize) * HugePageSize;
+      }
+
+      /**
+       * @brief Map anonymous memory with the best available huge page support.
+       *
+       * @param[in] bytes  The size of the allocation in bytes.
+       *
+       * @return The mapped memory or NULL if the mapping failed.
+       */
+      static void* mapMemory(const size_t bytes) {
+#if CODI_HasMMap
+        const size_t length = mappedSize(bytes);
+        void* ptr = MAP_FAILED;
+
+  #ifdef MAP_HUGETLB
+        if(UseExplicitHugePages) {
+          ptr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+  #endif
+
+        if(MAP_FAILED == ptr) {
+          ptr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+          if(MAP_FAILED == ptr) {
+            return NULL;
+          }
+
+  #ifdef MADV_HUGEPAGE
+          madvise(ptr, length, MADV_HUGEPAGE);
+  #endif
+        }
+
+        return ptr;
+#else
+        CODI_UNUSED(bytes);
+        return NULL;
+#endif
+      }
+
+      /**
+       * @brief Unmap memory from mapMemory.
+       *
+       * @param[in,out]   ptr  The mapped memory.
+       * @param[in]     bytes  The size that was used for the allocation of ptr.
+       */
+      static void unmapMemory(void* ptr, const size_t bytes) {
+#if CODI_HasMMap
+        munmap(ptr, mappedSize(bytes));
+#else
+        CODI_UNUSED(ptr);
+        CODI_UNUSED(bytes);
+#endif
+      }
+  };
+}
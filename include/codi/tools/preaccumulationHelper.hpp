@@ -29,16 +29,30 @@
 
 #pragma once
 
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
 #include "../configure.h"
 #include "../exceptions.hpp"
+#include "localWorkspaceHelper.hpp"
+#include "tapeGraph.hpp"
+#include "vertexEliminationHelper.hpp"
 
 /**
  * @brief Global namespace for CoDiPack - Code Differentiation Package
  */
 namespace codi {
 
+  /**
+   * @brief The methods for the computation of the Jacobi matrix in the PreaccumulationHelper.
+   */
+  enum class PreaccumulationMethod {
+    Sweeps, /**< One forward sweep per input or one reverse sweep per output over the tape */
+    LocalWorkspace, /**< Vector sweeps over a local workspace, see LocalWorkspaceHelper */
+    VertexElimination /**< Elimination of the intermediate values, see VertexEliminationHelper */
+  };
+
   /**
    * @brief Stores the Jacobi matrix for a code section.
    *
@@ -69,6 +83,29 @@ namespace codi {
    * The first argument to #finish is most of the times false. If it is set to true then the current adjoint values
    * in the tape will be stored before the preaccumulation is done and restored afterwards.
    *
+   * By default the Jacobi matrix is computed with one forward sweep per input or one reverse sweep per output over the
+   * tape, whichever requires fewer sweeps. With #setMethod one of the methods which work on the statement graph of the
+   * section can be selected:
+   *  - PreaccumulationMethod::LocalWorkspace: Several directions are evaluated at once on a small workspace which is
+   *    indexed by the statements of the section. The adjoint vector of the tape is not used.
+   *  - PreaccumulationMethod::VertexElimination: The intermediate values are eliminated from the statement graph.
+   *    This requires fewer operations if the section has many inputs and outputs.
+   *
+   * Tapes that do not store the Jacobians of the statements always use the sweeps over the tape.
+   *
+   * Before the Jacobi matrix is stored, inputs that appear several times are reduced to their first appearance and
+   * the non zero entries of each output are collected in a sparsity pattern. If the same code region is preaccumulated
+   * many times, e.g. a flux computation for each cell, the pattern can be cached with #setPatternKey. The cached
+   * pattern is reused as long as the inputs are duplicated at the same positions and no entry outside of the pattern
+   * is non zero, otherwise it is recreated or extended.
+   *
+   * With PreaccumulationMethod::VertexElimination and a Jacobi tape with a linear index handler, the compiled
+   * elimination of the region is cached for the key, too. Later regions only read the Jacobians of the statements from
+   * the tape, no statement graph is created and the elimination order is not planned again, as long as the recorded
+   * structure is the same. The statements of each region are still recorded on the tape and removed by #finish, the
+   * cache does not reduce the recording time or the temporary growth of the tape. For tapes with other index
+   * handlers, the elimination is always computed on the statement graph.
+   *
    * The preaccumulation helper can be used multiple times, the start routine resets the state such that multiple
    * evaluations are possible. This improves the performance of the helper since stack allocations are only performed
    * once.
@@ -98,6 +135,127 @@ namespace codi {
       std::vector<Real> jacobie; /**< The Jacobi matrix used to hold the result of the preaccumulation. */
       std::vector<int> nonZeros; /**< The number of nonzero values for each output value in the Jacobi matrix. */
 
+    private:
+
+      PreaccumulationMethod method; /**< The method for the computation of the Jacobi matrix */
+      TapeGraph<Tape> graph; /**< The statement graph of the section for the graph based methods */
+      LocalWorkspaceHelper<Tape> localWorkspace; /**< The vector sweeps on the statement graph */
+      VertexEliminationHelper<Tape> vertexElimination; /**< The elimination of the statement graph */
+      std::vector<GradientData> outputIndices; /**< The identifiers of the outputs for the graph based methods */
+
+      /**
+       * @brief The sparsity pattern of the Jacobi matrix of a preaccumulated region.
+       */
+      struct Pattern {
+          size_t inputSize; /**< The number of inputs of the region */
+          size_t outputSize; /**< The number of outputs of the region */
+          std::vector<size_t> firstInput; /**< For each input the position of the first input with the same identifier */
+          std::vector<size_t> duplicateInputs; /**< The positions of the inputs which are not a first appearance */
+          std::vector<bool> mask; /**< True for the entries of the Jacobi matrix which are in the pattern */
+          std::vector<size_t> entryOffsets; /**< The start of the entries of each output, has one additional entry */
+          std::vector<size_t> entryInputs; /**< The input positions of the entries in the pattern */
+
+          /**
+           * @brief Create an empty pattern.
+           */
+          Pattern() :
+            inputSize(0),
+            outputSize(0),
+            firstInput(),
+            duplicateInputs(),
+            mask(),
+            entryOffsets(),
+            entryInputs() {}
+      };
+
+      size_t patternKey; /**< The key of the current region in the pattern cache */
+      Pattern localPattern; /**< The pattern if no key is set */
+      std::vector<size_t> firstInput; /**< For each current input the position of its first appearance */
+      std::unordered_map<GradientData, size_t> firstAppearance; /**< Helper map for the computation of firstInput */
+      std::unordered_map<size_t, Pattern> patternCache; /**< The cached patterns for each key */
+      std::unordered_map<size_t, VertexEliminationHelper<Tape> > eliminationCache; /**< The compiled eliminations for each key */
+      size_t eliminationCacheHits; /**< The number of regions that have been computed with a cached elimination */
+      size_t eliminationCacheMisses; /**< The number of regions where the cached elimination could not be used */
+
+    public:
+
+      /** @brief Key value which disables the pattern cache. */
+      static const size_t NoPatternKey = std::numeric_limits<size_t>::max();
+
+      /**
+       * @brief Create a helper which uses forward or reverse sweeps for the preaccumulation.
+       */
+      PreaccumulationHelper() :
+        inputData(),
+        outputData(),
+        startPos(),
+        storedAdjoints(),
+        jacobie(),
+        nonZeros(),
+        method(PreaccumulationMethod::Sweeps),
+        graph(),
+        localWorkspace(),
+        vertexElimination(),
+        outputIndices(),
+        patternKey(NoPatternKey),
+        localPattern(),
+        firstInput(),
+        firstAppearance(),
+        patternCache(),
+        eliminationCache(),
+        eliminationCacheHits(0),
+        eliminationCacheMisses(0) {}
+
+      /**
+       * @brief Select the method for the computation of the Jacobi matrix.
+       *
+       * @param[in] newMethod  The method for the following preaccumulations.
+       */
+      void setMethod(PreaccumulationMethod newMethod) {
+        method = newMethod;
+      }
+
+      /**
+       * @brief Select the cached sparsity pattern for the following preaccumulations.
+       *
+       * All regions that use the same key need to have the same structure, e.g. they are evaluations of the same code
+       * for different data. With PreaccumulationMethod::VertexElimination, the compiled elimination is cached for the
+       * key if the tape has a linear index handler.
+       *
+       * @param[in] key  The key of the region or NoPatternKey to disable the cache.
+       */
+      void setPatternKey(size_t key) {
+        patternKey = key;
+      }
+
+      /**
+       * @brief Remove all cached sparsity patterns and compiled eliminations.
+       */
+      void clearPatternCache() {
+        patternCache.clear();
+        eliminationCache.clear();
+      }
+
+      /**
+       * @brief The number of regions whose Jacobian was computed with a cached compiled elimination.
+       *
+       * @return The number of cache hits since the creation of the helper.
+       */
+      size_t getEliminationCacheHits() const {
+        return eliminationCacheHits;
+      }
+
+      /**
+       * @brief The number of regions where the cached compiled elimination was missing or did not match the region.
+       *
+       * Only regions which could use the cache are counted, see #setPatternKey.
+       *
+       * @return The number of cache misses since the creation of the helper.
+       */
+      size_t getEliminationCacheMisses() const {
+        return eliminationCacheMisses;
+      }
+
       /**
        * @brief Add extra inputs to the preaccumulated section.
        *
@@ -288,6 +446,133 @@ namespace codi {
         }
       }
 
+      /**
+       * @brief Select the sparsity pattern for the current Jacobi matrix and count the non zero entries.
+       *
+       * A cached pattern is recreated if the number of outputs differs or if the inputs are not duplicated at the same
+       * positions. It is extended if an entry outside of the pattern is non zero.
+       *
+       * @return The pattern of the current Jacobi matrix.
+       */
+      const Pattern& compressJacobian() {
+        const size_t inputSize = inputData.size();
+        const size_t outputSize = outputData.size();
+
+        firstAppearance.clear();
+        firstInput.resize(inputSize);
+        for(size_t curIn = 0; curIn < inputSize; ++curIn) {
+          firstInput[curIn] = firstAppearance.insert(std::make_pair(inputData[curIn], curIn)).first->second;
+        }
+
+        Pattern& pattern = NoPatternKey == patternKey ? localPattern : patternCache[patternKey];
+
+        bool sameInputs = NoPatternKey != patternKey && outputSize == pattern.outputSize && firstInput == pattern.firstInput;
+
+        if(!sameInputs || !countNonZeros(pattern, true)) {
+          createPattern(pattern, sameInputs);
+          countNonZeros(pattern, false);
+        }
+
+        return pattern;
+      }
+
+      /**
+       * @brief Count the non zero entries of each output in the pattern.
+       *
+       * The check compares the number of non zero entries in each row of the Jacobi matrix with the number of non zero
+       * entries in the pattern. This is one linear pass over the rows and no lookup in the mask of the pattern is
+       * required.
+       *
+       * @param[in] pattern  The pattern of the current Jacobi matrix.
+       * @param[in]   check  If true, the counting stops at the first row with a non zero entry outside of the pattern.
+       *
+       * @return False if the check is enabled and an entry outside of the pattern is non zero.
+       */
+      bool countNonZeros(const Pattern& pattern, bool check) {
+        const size_t inputSize = inputData.size();
+        const size_t outputSize = outputData.size();
+
+        for(size_t curOut = 0; curOut < outputSize; ++curOut) {
+          const Real* row = jacobie.data() + curOut * inputSize;
+
+          int patternNonZeros = 0;
+          for(size_t curEntry = pattern.entryOffsets[curOut]; curEntry < pattern.entryOffsets[curOut + 1]; ++curEntry) {
+            patternNonZeros += (int)(0.0 != row[pattern.entryInputs[curEntry]]);
+          }
+          nonZeros[curOut] = patternNonZeros;
+
+          if(check) {
+            int rowNonZeros = 0;
+            for(size_t curIn = 0; curIn < inputSize; ++curIn) {
+              rowNonZeros += (int)(0.0 != row[curIn]);
+            }
+            for(size_t curDup = 0; curDup < pattern.duplicateInputs.size(); ++curDup) {
+              rowNonZeros -= (int)(0.0 != row[pattern.duplicateInputs[curDup]]);
+            }
+
+            if(rowNonZeros != patternNonZeros) {
+              return false;
+            }
+          }
+        }
+
+        return true;
+      }
+
+      /**
+       * @brief Create the sparsity pattern from the non zero entries of the current Jacobi matrix.
+       *
+       * Only the first appearance of an input is added to the pattern. All appearances of the same identifier describe
+       * the derivative with respect to the same value.
+       *
+       * @param[in,out] pattern  The pattern which is created.
+       * @param[in]      extend  If true, the entries of the old pattern are kept.
+       */
+      void createPattern(Pattern& pattern, bool extend) {
+        const size_t inputSize = inputData.size();
+        const size_t outputSize = outputData.size();
+
+        if(!extend) {
+          pattern.inputSize = inputSize;
+          pattern.outputSize = outputSize;
+          pattern.mask.assign(inputSize * outputSize, false);
+          pattern.firstInput = firstInput;
+
+          pattern.duplicateInputs.clear();
+          for(size_t curIn = 0; curIn < inputSize; ++curIn) {
+            if(firstInput[curIn] != curIn) {
+              pattern.duplicateInputs.push_back(curIn);
+            }
+          }
+        }
+
+        pattern.entryOffsets.assign(1, 0);
+        pattern.entryInputs.clear();
+        for(size_t curOut = 0; curOut < outputSize; ++curOut) {
+          for(size_t curIn = 0; curIn < inputSize; ++curIn) {
+            const size_t pos = curIn + curOut * inputSize;
+            if(firstInput[curIn] == curIn && (pattern.mask[pos] || 0.0 != jacobie[pos])) {
+              pattern.mask[pos] = true;
+              pattern.entryInputs.push_back(curIn);
+            }
+          }
+          pattern.entryOffsets.push_back(pattern.entryInputs.size());
+        }
+      }
+
+      /**
+       * @brief Check if the compiled elimination of the current region is cached.
+       *
+       * The structure of a recorded region can only be compared with the compiled one if the index handler provides
+       * linear indices. Primal value tapes do not provide the Jacobians for the compilation.
+       *
+       * @return True for the vertex elimination with a pattern key on a Jacobi tape with a linear index handler.
+       */
+      bool useEliminationCache() const {
+        return PreaccumulationMethod::VertexElimination == method && NoPatternKey != patternKey &&
+               Tape::AllowJacobiOptimization && Tape::LinearIndexHandler;
+      }
+
       /**
        * @brief Performs the actual preaccumulation.
        *
@@ -313,12 +598,49 @@ namespace codi {
         }
 
 
-        if(inputData.size() < outputData.size()) {
-          // forward accumulation of Jacobi
-
+        bool useGraph = PreaccumulationMethod::Sweeps != method;
+        bool isComputed = false;
+        if(useGraph) {
+          outputIndices.resize(outputData.size());
           for (size_t curOut = 0; curOut < outputData.size(); ++curOut) {
-            nonZeros[curOut] = 0;
+            outputIndices[curOut] = outputData[curOut]->getGradientData();
+          }
+
+          if(useEliminationCache()) {
+            // reuse the compiled elimination of the region
+            isComputed = eliminationCache[patternKey].evaluateRecorded(tape, startPos, endPos, inputData.data(),
+                                                                       inputData.size(), outputIndices.data(),
+                                                                       outputIndices.size(), jacobie.data());
+            if(isComputed) {
+              eliminationCacheHits += 1;
+            } else {
+              eliminationCacheMisses += 1;
+            }
+          }
+
+          if(!isComputed) {
+            graph.clear();
+            graph.read(tape, startPos, endPos);
+            useGraph = graph.jacobies.size() == graph.argumentIndices.size();
           }
+        }
+
+        if(isComputed) {
+          // Jacobi is already computed by the cached elimination
+        } else if(useGraph) {
+          // accumulation of Jacobi on the statement graph
+
+          if(PreaccumulationMethod::LocalWorkspace == method) {
+            localWorkspace.computeJacobian(graph, inputData.data(), inputData.size(), outputIndices.data(),
+                                           outputIndices.size(), jacobie.data());
+          } else {
+            VertexEliminationHelper<Tape>& elimination = useEliminationCache() ? eliminationCache[patternKey] :
+                                                                                 vertexElimination;
+            elimination.computeJacobian(graph, inputData.data(), inputData.size(), outputIndices.data(),
+                                        outputIndices.size(), jacobie.data());
+          }
+        } else if(inputData.size() < outputData.size()) {
+          // forward accumulation of Jacobi
 
           for (size_t curIn = 0; curIn < inputData.size(); ++curIn) {
 
@@ -331,10 +653,6 @@ namespace codi {
               GradientData indexOut = outputData[curOut]->getGradientData();
               GradientValue& adj = tape.gradient(indexOut);
               jacobie[curIn + curOut * inputData.size()] = adj;
-
-              if(0.0 != adj) {
-                nonZeros[curOut] += 1;
-              }
             }
 
             tape.setGradient(indexIn, 0.0);
@@ -346,7 +664,6 @@ namespace codi {
 
           for (size_t curOut = 0; curOut < outputData.size(); ++curOut) {
 
-            nonZeros[curOut] = 0;
             size_t jacobiOffset = curOut * inputData.size();
 
             GradientData indexOut = outputData[curOut]->getGradientData();
@@ -359,10 +676,6 @@ namespace codi {
               GradientValue& adj = tape.gradient(indexIn);
               jacobie[curIn + jacobiOffset] = adj;
 
-              if(0.0 != adj) {
-                nonZeros[curOut] += 1;
-              }
-
               adj = 0.0;
             }
 
@@ -370,6 +683,8 @@ namespace codi {
           }
         }
 
+        const Pattern& pattern = compressJacobian();
+
         // store the Jacobi matrix
         tape.reset(startPos);
 
@@ -382,7 +697,7 @@ namespace codi {
             // we need to use here the value of the gradient data such that it is correctly deleted.
             GradientData lastGradientData = value.getGradientData();
             bool staggeringActive = false;
-            int curIn = 0;
+            size_t curEntry = pattern.entryOffsets[curOut];
             size_t jacobiOffset = curOut * inputData.size();
 
             // push statements as long as there are non zeros left
@@ -409,11 +724,12 @@ namespace codi {
 
               // push the rest of the Jacobies for the statement
               while(jacobiesForStatement > 0) {
+                const size_t curIn = pattern.entryInputs[curEntry];
                 if(0.0 != jacobie[curIn + jacobiOffset]) {
                   tape.pushJacobiManual(jacobie[curIn + jacobiOffset], 0.0, inputData[curIn]);
                   jacobiesForStatement -= 1;
                 }
-                curIn += 1;
+                curEntry += 1;
               }
 
               staggeringActive = true;
@@ -428,6 +744,9 @@ namespace codi {
       }
   };
 
+  template<typename CoDiType>
+  const size_t PreaccumulationHelper<CoDiType>::NoPatternKey;
+
   /**
    * Helper implementation of the same interface as the PreaccumulationHelper for forward AD tapes.
    *
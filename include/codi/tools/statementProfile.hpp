@@ -0,0 +1,236 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  #include <x86intrin.h>
+  #define CODI_HasCycleCounter 1
+#else
+  #define CODI_HasCycleCounter 0
+#endif
+
+#include "../configure.h"
+#include "typeName.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Profile of the reverse evaluation per statement handle.
+   *
+   * The primal value tapes evaluate each statement through a handle which is created for each expression type. If
+   * CoDiPack is compiled with CODI_EnableStatementProfile=true, the tapes register the name of the expression for each
+   * handle and measure the reverse evaluation of each statement. The results are aggregated per handle.
+   *
+   * The time is measured in CPU cycles on x86 architectures (rdtsc) and in nanoseconds otherwise. The measurement
+   * adds to each statement two reads of the counter and a lookup of the handle in an unordered map. This overhead is
+   * included in the results.
+   *
+   * There is one global profile for each handle type, which is shared by all tapes that use this handle type. The
+   * profile is not thread-safe. If several tapes are evaluated in parallel, the updates of the entries are data races.
+   *
+   * @tparam Handle  The handle type of the handle factory.
+   */
+  template<typename Handle>
+  struct StatementProfile {
+
+      /**
+       * @brief The aggregated data for one handle.
+       */
+      struct Entry {
+        std::string name; /**< The demangled name of the expression */
+        size_t count;     /**< The number of reverse evaluations */
+        uint64_t cycles;  /**< The accumulated cycles of the reverse evaluations */
+
+        /**
+         * @brief Create an entry without evaluations.
+         */
+        Entry() :
+          name("unknown"),
+          count(0),
+          cycles(0) {}
+      };
+
+    private:
+
+      std::unordered_map<Handle, Entry> entries; /**< The data for all handles that have been seen */
+
+    public:
+
+      /**
+       * @brief The global instance for the handle type.
+       *
+       * @return The global instance.
+       */
+      static StatementProfile& get() {
+        static StatementProfile instance;
+
+        return instance;
+      }
+
+      /**
+       * @brief The current value of the cycle counter.
+       *
+       * @return The cycles on x86 architectures, otherwise nanoseconds.
+       */
+      static CODI_INLINE uint64_t now() {
+#if CODI_HasCycleCounter
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+      }
+
+      /**
+       * @brief Register the name of the expression for the handle.
+       *
+       * The registration is performed once for every combination of the template arguments.
+       *
+       * @param[in] handle  The handle that was created for the expression.
+       *
+       * @tparam Expr  The expression of the handle.
+       * @tparam Tape  The tape that created the handle.
+       */
+      template<typename Expr, typename Tape>
+      static CODI_INLINE void registerHandle(const Handle& handle) {
+        static const bool registered = get().setName(handle, demangleTypeName(typeid(Expr).name()));
+        CODI_UNUSED(registered);
+      }
+
+      /**
+       * @brief Add one evaluation of a handle.
+       *
+       * @param[in] handle  The evaluated handle.
+       * @param[in]  start  The value of #now before the evaluation.
+       */
+      CODI_INLINE void addEvaluation(const Handle& handle, uint64_t start) {
+        uint64_t end = now();
+
+        Entry& entry = entries[handle];
+        entry.count += 1;
+        entry.cycles += end - start;
+      }
+
+      /**
+       * @brief Set the count and cycles of all handles to zero.
+       *
+       * The names of the handles are kept.
+       */
+      void reset() {
+        for(typename std::unordered_map<Handle, Entry>::iterator iter = entries.begin(); iter != entries.end(); ++iter) {
+          iter->second.count = 0;
+          iter->second.cycles = 0;
+        }
+      }
+
+      /**
+       * @brief Get the data of all handles that have been evaluated.
+       *
+       * @return The entries sorted by the accumulated cycles, the most expensive first.
+       */
+      std::vector<Entry> getEntries() const {
+        std::vector<Entry> result;
+        for(typename std::unordered_map<Handle, Entry>::const_iterator iter = entries.begin(); iter != entries.end(); ++iter) {
+          if(0 != iter->second.count) {
+            result.push_back(iter->second);
+          }
+        }
+
+        std::sort(result.begin(), result.end(), [](const Entry& a, const Entry& b) { return a.cycles > b.cycles; });
+
+        return result;
+      }
+
+      /**
+       * @brief Output the profile as a table.
+       *
+       * The columns are the number of evaluations, the accumulated cycles, the cycles per evaluation, the share of
+       * the total cycles and the expression name. The format flags of the stream are restored afterwards.
+       *
+       * @param[in,out] out  The stream for the output.
+       *
+       * @tparam Stream  Needs to implement stream operations.
+       */
+      template<typename Stream = std::ostream>
+      void formatDefault(Stream& out = std::cout) const {
+        std::vector<Entry> sorted = getEntries();
+
+        uint64_t totalCycles = 0;
+        for(const Entry& entry : sorted) {
+          totalCycles += entry.cycles;
+        }
+
+        std::ios::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+
+        out << std::setw(12) << "Count" << " " << std::setw(14) << "Cycles" << " " << std::setw(11) << "Cycles/eval"
+            << " " << std::setw(7) << "Share" << "  " << "Expression" << "\n";
+        for(const Entry& entry : sorted) {
+          double perEval = (double)entry.cycles / (double)entry.count;
+          double share = 0 == totalCycles ? 0.0 : 100.0 * (double)entry.cycles / (double)totalCycles;
+
+          out << std::setw(12) << entry.count << " " << std::setw(14) << entry.cycles << " "
+              << std::setiosflags(std::ios::fixed) << std::setprecision(1) << std::setw(11) << perEval << " "
+              << std::setw(6) << share << "%  " << entry.name << "\n";
+        }
+
+        out.flags(flags);
+        out.precision(precision);
+      }
+
+    private:
+
+      /**
+       * @brief Store the name for a handle.
+       *
+       * @param[in] handle  The handle of the expression.
+       * @param[in]   name  The name of the expression.
+       *
+       * @return Always true.
+       */
+      bool setName(const Handle& handle, const std::string& name) {
+        entries[handle].name = name;
+
+        return true;
+      }
+  };
+}
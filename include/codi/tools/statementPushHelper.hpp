@@ -84,6 +84,9 @@ namespace codi {
    * sh.pushStatement(y, x.value() * x.value(), values, jacobies, 1);
    * \endcode
    *
+   * The arguments are stored on the tape as they are pushed, the JacobianSorter is not used. Arguments with the same
+   * identifier are not combined, this has to be done by the caller if it is required.
+   *
    * @tparam CoDiType  This needs to be one of the CoDiPack types defined through an ActiveReal
    */
   template<typename CoDiType>
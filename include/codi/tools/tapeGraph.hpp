@@ -0,0 +1,427 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../configure.h"
+#include "io.hpp"
+#include "typeName.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief The statement graph of a recorded tape.
+   *
+   * The graph is read with the forEachStatement method of the tape. Each statement is a node in the graph, the
+   * arguments of the statements define the edges. An argument is connected to the last statement in the read range
+   * that has written its index. Arguments that are not written in the range are the inputs of the graph. Since the
+   * edges are defined by the order of the statements, the graph is also correct for tapes that reuse indices.
+   *
+   * Jacobi tapes provide the Jacobians of the arguments. Primal value tapes provide the name of the operation instead.
+   *
+   * The graph can be written in the DOT format of Graphviz, in the GraphML format or in a compact binary format.
+   *
+   * \code{.cpp}
+   *   codi::TapeGraph<codi::RealReverse::TapeType> graph(tape, start, end);
+   *   graph.writeDot(std::cout);
+   * \endcode
+   *
+   * @tparam Tape  A reverse tape which implements forEachStatement.
+   */
+  template<typename Tape>
+  struct TapeGraph {
+
+      typedef typename Tape::Real Real; /**< The floating point calculation type of the tape */
+      typedef typename Tape::Index Index; /**< The index type of the tape */
+      typedef typename Tape::Position Position; /**< The position type of the tape */
+
+      /** @brief Marker for an argument that is not written by a statement in the graph. */
+      static const size_t InputArgument = std::numeric_limits<size_t>::max();
+
+      std::vector<Index> lhsIndices; /**< The lhs index of each statement */
+      std::vector<size_t> argumentOffsets; /**< The start of the arguments of each statement, has one additional entry */
+      std::vector<Index> argumentIndices; /**< The indices of the arguments */
+      std::vector<size_t> argumentStatements; /**< The statement that has written each argument or InputArgument */
+      std::vector<Real> jacobies; /**< The Jacobians of the arguments, empty if the tape does not provide them */
+      std::vector<size_t> operations; /**< The operation of each statement, empty if the tape does not provide them */
+      std::vector<std::string> operationNames; /**< The demangled names of the operations */
+
+    private:
+
+      std::unordered_map<Index, size_t> lastWriter; /**< The statement which has written an index last */
+      std::unordered_map<const char*, size_t> operationIds; /**< The operation id for each mangled name */
+
+    public:
+
+      /**
+       * @brief Creates an empty graph.
+       */
+      TapeGraph() :
+        lhsIndices(),
+        argumentOffsets(1, 0),
+        argumentIndices(),
+        argumentStatements(),
+        jacobies(),
+        operations(),
+        operationNames(),
+        lastWriter(),
+        operationIds() {}
+
+      /**
+       * @brief Read the statements between the start and the end position of the tape.
+       *
+       * @param[in,out] tape  The tape that provides the statements.
+       * @param[in]    start  The starting position.
+       * @param[in]      end  The ending position.
+       */
+      TapeGraph(Tape& tape, const Position& start, const Position& end) :
+        TapeGraph() {
+        read(tape, start, end);
+      }
+
+      /**
+       * @brief Read all statements of the tape.
+       *
+       * @param[in,out] tape  The tape that provides the statements.
+       */
+      explicit TapeGraph(Tape& tape) :
+        TapeGraph(tape, tape.getZeroPosition(), tape.getPosition()) {}
+
+      /**
+       * @brief Append the statements between the start and the end position of the tape to the graph.
+       *
+       * @param[in,out] tape  The tape that provides the statements.
+       * @param[in]    start  The starting position.
+       * @param[in]      end  The ending position.
+       */
+      void read(Tape& tape, const Position& start, const Position& end) {
+        tape.forEachStatement(start, end, [this] (const Index& lhsIndex, size_t nArgs, const Index* indices,
+                                                  const Real* argJacobies, const char* operation) {
+          this->addStatement(lhsIndex, nArgs, indices, argJacobies, operation);
+        });
+      }
+
+      /**
+       * @brief Remove all statements from the graph.
+       */
+      void clear() {
+        lhsIndices.clear();
+        argumentOffsets.assign(1, 0);
+        argumentIndices.clear();
+        argumentStatements.clear();
+        jacobies.clear();
+        operations.clear();
+        operationNames.clear();
+        lastWriter.clear();
+        operationIds.clear();
+      }
+
+      /**
+       * @brief The number of statements in the graph.
+       *
+       * @return The number of statements.
+       */
+      size_t getStatementCount() const {
+        return lhsIndices.size();
+      }
+
+      /**
+       * @brief The number of arguments of all statements in the graph.
+       *
+       * @return The number of edges.
+       */
+      size_t getArgumentCount() const {
+        return argumentIndices.size();
+      }
+
+      /**
+       * @brief Add one statement to the graph.
+       *
+       * @param[in]    lhsIndex  The index of the lhs.
+       * @param[in]       nArgs  The number of arguments.
+       * @param[in]     indices  The indices of the arguments.
+       * @param[in] argJacobies  The Jacobians of the arguments or NULL.
+       * @param[in]   operation  The mangled name of the operation or NULL.
+       */
+      void addStatement(const Index& lhsIndex, size_t nArgs, const Index* indices, const Real* argJacobies, const char* operation) {
+        const size_t stmt = lhsIndices.size();
+
+        for(size_t i = 0; i < nArgs; ++i) {
+          typename std::unordered_map<Index, size_t>::const_iterator writer = lastWriter.find(indices[i]);
+
+          argumentIndices.push_back(indices[i]);
+          argumentStatements.push_back(lastWriter.end() == writer ? InputArgument : writer->second);
+          if(NULL != argJacobies) {
+            jacobies.push_back(argJacobies[i]);
+          }
+        }
+
+        if(NULL != operation) {
+          std::pair<typename std::unordered_map<const char*, size_t>::iterator, bool> id =
+              operationIds.insert(std::make_pair(operation, operationNames.size()));
+          if(id.second) {
+            operationNames.push_back(demangleTypeName(operation));
+          }
+          operations.push_back(id.first->second);
+        }
+
+        lhsIndices.push_back(lhsIndex);
+        argumentOffsets.push_back(argumentIndices.size());
+        lastWriter[lhsIndex] = stmt;
+      }
+
+      /**
+       * @brief Check if every index is written at most once and not read before it is written.
+       *
+       * This is the case for the graph of a tape with a linear index handler.
+       *
+       * @return True if every index has a unique producer in the graph.
+       */
+      bool isSingleAssignment() const {
+        std::unordered_map<Index, bool> used;
+        for(size_t stmt = 0; stmt < lhsIndices.size(); ++stmt) {
+          for(size_t arg = argumentOffsets[stmt]; arg < argumentOffsets[stmt + 1]; ++arg) {
+            if(InputArgument == argumentStatements[arg]) {
+              used[argumentIndices[arg]] = true;
+            }
+          }
+          if(!used.insert(std::make_pair(lhsIndices[stmt], true)).second) {
+            return false;
+          }
+        }
+
+        return true;
+      }
+
+      /**
+       * @brief Write the graph in the DOT format of Graphviz.
+       *
+       * Statements are written as boxes with the lhs index and the operation, inputs as ellipses with their index. The
+       * edges are labeled with the Jacobians.
+       *
+       * @param[in,out] out  The stream for the output.
+       */
+      void writeDot(std::ostream& out) const {
+        out << "digraph CoDiTape {\n";
+
+        std::unordered_map<Index, bool> inputWritten;
+        for(size_t arg = 0; arg < argumentIndices.size(); ++arg) {
+          if(InputArgument == argumentStatements[arg] && inputWritten.insert(std::make_pair(argumentIndices[arg], true)).second) {
+            out << "  i" << argumentIndices[arg] << " [shape=ellipse, label=\"" << argumentIndices[arg] << "\"];\n";
+          }
+        }
+
+        for(size_t stmt = 0; stmt < lhsIndices.size(); ++stmt) {
+          out << "  s" << stmt << " [shape=box, label=\"" << lhsIndices[stmt];
+          if(!operations.empty()) {
+            out << "\\n";
+            writeEscaped(out, operationNames[operations[stmt]], false);
+          }
+          out << "\"];\n";
+        }
+
+        for(size_t stmt = 0; stmt < lhsIndices.size(); ++stmt) {
+          for(size_t arg = argumentOffsets[stmt]; arg < argumentOffsets[stmt + 1]; ++arg) {
+            if(InputArgument == argumentStatements[arg]) {
+              out << "  i" << argumentIndices[arg];
+            } else {
+              out << "  s" << argumentStatements[arg];
+            }
+            out << " -> s" << stmt;
+            if(!jacobies.empty()) {
+              out << " [label=\"" << jacobies[arg] << "\"]";
+            }
+            out << ";\n";
+          }
+        }
+
+        out << "}\n";
+      }
+
+      /**
+       * @brief Write the graph in the GraphML format.
+       *
+       * The nodes have the attributes "index" and "kind" (input or statement), statements also "operation" if the
+       * tape provides it. The edges have the attribute "jacobian" if the tape provides it.
+       *
+       * @param[in,out] out  The stream for the output.
+       */
+      void writeGraphML(std::ostream& out) const {
+        out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        out << "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n";
+        out << "  <key id=\"index\" for=\"node\" attr.name=\"index\" attr.type=\"long\"/>\n";
+        out << "  <key id=\"kind\" for=\"node\" attr.name=\"kind\" attr.type=\"string\"/>\n";
+        out << "  <key id=\"operation\" for=\"node\" attr.name=\"operation\" attr.type=\"string\"/>\n";
+        out << "  <key id=\"jacobian\" for=\"edge\" attr.name=\"jacobian\" attr.type=\"double\"/>\n";
+        out << "  <graph id=\"CoDiTape\" edgedefault=\"directed\">\n";
+
+        std::unordered_map<Index, bool> inputWritten;
+        for(size_t arg = 0; arg < argumentIndices.size(); ++arg) {
+          if(InputArgument == argumentStatements[arg] && inputWritten.insert(std::make_pair(argumentIndices[arg], true)).second) {
+            out << "    <node id=\"i" << argumentIndices[arg] << "\"><data key=\"index\">" << argumentIndices[arg]
+                << "</data><data key=\"kind\">input</data></node>\n";
+          }
+        }
+
+        for(size_t stmt = 0; stmt < lhsIndices.size(); ++stmt) {
+          out << "    <node id=\"s" << stmt << "\"><data key=\"index\">" << lhsIndices[stmt]
+              << "</data><data key=\"kind\">statement</data>";
+          if(!operations.empty()) {
+            out << "<data key=\"operation\">";
+            writeEscaped(out, operationNames[operations[stmt]], true);
+            out << "</data>";
+          }
+          out << "</node>\n";
+        }
+
+        for(size_t stmt = 0; stmt < lhsIndices.size(); ++stmt) {
+          for(size_t arg = argumentOffsets[stmt]; arg < argumentOffsets[stmt + 1]; ++arg) {
+            out << "    <edge source=\"";
+            if(InputArgument == argumentStatements[arg]) {
+              out << "i" << argumentIndices[arg];
+            } else {
+              out << "s" << argumentStatements[arg];
+            }
+            out << "\" target=\"s" << stmt << "\"";
+            if(!jacobies.empty()) {
+              out << "><data key=\"jacobian\">" << jacobies[arg] << "</data></edge>\n";
+            } else {
+              out << "/>\n";
+            }
+          }
+        }
+
+        out << "  </graph>\n";
+        out << "</graphml>\n";
+      }
+
+      /**
+       * @brief Write the graph in a compact binary format.
+       *
+       * All values are written in the native byte order. The layout is:
+       *  - char[8]: "CODIGRPH"
+       *  - uint32_t: version (1), sizeof(Index), sizeof(Real), has Jacobians (0/1), has operations (0/1)
+       *  - uint64_t: number of statements n, number of arguments m
+       *  - Index[n]: lhs indices
+       *  - uint64_t[n + 1]: argument offsets
+       *  - Index[m]: argument indices
+       *  - uint64_t[m]: statement of the argument, UINT64_MAX for inputs
+       *  - Real[m]: Jacobians, if available
+       *  - if operations are available: uint64_t[n] operation ids, uint64_t number of names, for each name the
+       *    uint64_t length and the characters
+       *
+       * @param[in] filename  The file for the output.
+       */
+      void writeBinary(const std::string& filename) const {
+        CoDiIoHandle handle(filename, true);
+
+        const char magic[8] = {'C', 'O', 'D', 'I', 'G', 'R', 'P', 'H'};
+        handle.writeData(magic, 8);
+
+        const bool writeJacobies = !jacobies.empty();
+        const bool writeOperations = !operations.empty();
+        const uint32_t header[5] = {1, (uint32_t)sizeof(Index), (uint32_t)sizeof(Real), writeJacobies, writeOperations};
+        handle.writeData(header, 5);
+
+        const uint64_t sizes[2] = {lhsIndices.size(), argumentIndices.size()};
+        handle.writeData(sizes, 2);
+
+        handle.writeData(lhsIndices.data(), lhsIndices.size());
+        writeSizes(handle, argumentOffsets);
+        handle.writeData(argumentIndices.data(), argumentIndices.size());
+        writeSizes(handle, argumentStatements);
+        if(writeJacobies) {
+          handle.writeData(jacobies.data(), jacobies.size());
+        }
+
+        if(writeOperations) {
+          writeSizes(handle, operations);
+
+          const uint64_t nNames = operationNames.size();
+          handle.writeData(&nNames, 1);
+          for(const std::string& name : operationNames) {
+            const uint64_t length = name.size();
+            handle.writeData(&length, 1);
+            handle.writeData(name.data(), name.size());
+          }
+        }
+      }
+
+    private:
+
+      /**
+       * @brief Write a vector of sizes as 64 bit values.
+       *
+       * @param[in,out] handle  The file handle.
+       * @param[in]     values  The values that are written.
+       */
+      static void writeSizes(CoDiIoHandle& handle, const std::vector<size_t>& values) {
+        std::vector<uint64_t> converted(values.begin(), values.end());
+        handle.writeData(converted.data(), converted.size());
+      }
+
+      /**
+       * @brief Write a string with the escape sequences for DOT labels or XML.
+       *
+       * @param[in,out] out  The stream for the output.
+       * @param[in]    text  The text that is written.
+       * @param[in]     xml  true for XML, false for DOT.
+       */
+      static void writeEscaped(std::ostream& out, const std::string& text, bool xml) {
+        for(char c : text) {
+          if(xml) {
+            switch (c) {
+            case '<': out << "&lt;"; break;
+            case '>': out << "&gt;"; break;
+            case '&': out << "&amp;"; break;
+            case '"': out << "&quot;"; break;
+            default: out << c; break;
+            }
+          } else {
+            if('"' == c || '\\' == c) {
+              out << '\\';
+            }
+            out << c;
+          }
+        }
+      }
+  };
+
+  template<typename Tape>
+  const size_t TapeGraph<Tape>::InputArgument;
+}
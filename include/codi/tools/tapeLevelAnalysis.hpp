@@ -0,0 +1,171 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "../configure.h"
+#include "tapeGraph.hpp"
+#include "tapeValues.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Level and critical path analysis of a tape graph.
+   *
+   * Each statement is assigned to a level such that all statements that compute its arguments are on a lower level.
+   * Statements that depend only on inputs are on level 1. All statements on the same level are independent of each
+   * other and could be evaluated in parallel, the number of levels is the length of the critical path.
+   *
+   * The analysis considers only the data dependencies of the graph. For tapes which reuse indices, a parallel
+   * evaluation would also need to respect the reuse of the adjoint entries by statements on different levels.
+   *
+   * The results can be added to the tape values:
+   * \code{.cpp}
+   *   codi::TapeLevelAnalysis<codi::RealReverse::TapeType> analysis(codi::TapeGraph<codi::RealReverse::TapeType>(tape));
+   *   codi::TapeValues values = tape.getTapeValues();
+   *   analysis.addValues(values);
+   *   values.formatDefault();
+   * \endcode
+   *
+   * @tparam Tape  A reverse tape which implements forEachStatement.
+   */
+  template<typename Tape>
+  struct TapeLevelAnalysis {
+
+      std::vector<size_t> levels; /**< The level of each statement, starting with 1 */
+      std::vector<size_t> levelWidths; /**< The number of statements on each level, the entry for level 0 is unused */
+
+      size_t criticalPathLength; /**< The number of levels */
+      size_t criticalPathArguments; /**< The maximum number of arguments on a dependency path through the graph */
+      size_t totalArguments; /**< The number of arguments of all statements */
+
+      /**
+       * @brief Compute the levels for the statements of the graph.
+       *
+       * @param[in] graph  The statement graph of a tape.
+       */
+      explicit TapeLevelAnalysis(const TapeGraph<Tape>& graph) :
+        levels(graph.getStatementCount()),
+        levelWidths(1, 0),
+        criticalPathLength(0),
+        criticalPathArguments(0),
+        totalArguments(graph.getArgumentCount()) {
+
+        std::vector<size_t> pathArguments(graph.getStatementCount());
+
+        for(size_t stmt = 0; stmt < graph.getStatementCount(); ++stmt) {
+          size_t level = 1;
+          size_t maxPath = 0;
+          for(size_t arg = graph.argumentOffsets[stmt]; arg < graph.argumentOffsets[stmt + 1]; ++arg) {
+            const size_t source = graph.argumentStatements[arg];
+            if(TapeGraph<Tape>::InputArgument != source) {
+              level = std::max(level, levels[source] + 1);
+              maxPath = std::max(maxPath, pathArguments[source]);
+            }
+          }
+
+          levels[stmt] = level;
+          pathArguments[stmt] = maxPath + (graph.argumentOffsets[stmt + 1] - graph.argumentOffsets[stmt]);
+
+          if(levelWidths.size() <= level) {
+            levelWidths.resize(level + 1, 0);
+          }
+          levelWidths[level] += 1;
+
+          criticalPathLength = std::max(criticalPathLength, level);
+          criticalPathArguments = std::max(criticalPathArguments, pathArguments[stmt]);
+        }
+      }
+
+      /**
+       * @brief The largest number of statements on one level.
+       *
+       * @return The maximum level width.
+       */
+      size_t getMaximumWidth() const {
+        return *std::max_element(levelWidths.begin(), levelWidths.end());
+      }
+
+      /**
+       * @brief The average number of statements per level.
+       *
+       * @return The number of statements divided by the critical path length.
+       */
+      double getAverageWidth() const {
+        return 0 == criticalPathLength ? 0.0 : (double)levels.size() / (double)criticalPathLength;
+      }
+
+      /**
+       * @brief Add the results as a new section to the tape values.
+       *
+       * The histogram of the level widths uses buckets of the powers of two, e.g. the levels with a width from 4 to 7.
+       *
+       * @param[in,out] values  The information is added to the values.
+       */
+      void addValues(TapeValues& values) const {
+        values.addSection("Level analysis");
+        values.addData("Statements", levels.size());
+        values.addData("Arguments", totalArguments);
+        values.addData("Critical path length", criticalPathLength);
+        values.addData("Critical path arguments", criticalPathArguments);
+        values.addData("Maximum level width", getMaximumWidth());
+        values.addData("Average level width", (size_t)(getAverageWidth() + 0.5));
+
+        std::vector<size_t> histogram;
+        for(size_t level = 1; level < levelWidths.size(); ++level) {
+          size_t bucket = 0;
+          while((size_t)2 << bucket <= levelWidths[level]) {
+            bucket += 1;
+          }
+
+          if(histogram.size() <= bucket) {
+            histogram.resize(bucket + 1, 0);
+          }
+          histogram[bucket] += 1;
+        }
+
+        for(size_t bucket = 0; bucket < histogram.size(); ++bucket) {
+          const size_t lower = (size_t)1 << bucket;
+          const size_t upper = ((size_t)2 << bucket) - 1;
+
+          std::string name = "Levels of width " + std::to_string(lower);
+          if(lower != upper) {
+            name += "-" + std::to_string(upper);
+          }
+          values.addData(name, histogram[bucket]);
+        }
+      }
+  };
+}
@@ -0,0 +1,283 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "../configure.h"
+#include "../exceptions.hpp"
+#include "tapeGraph.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Records the statements of a Jacobi tape in a new order that improves the locality of the adjoint accesses.
+   *
+   * The recorded order of the statements follows the program order, the arguments of a statement can therefore be
+   * anywhere in the adjoint vector. The helper computes a topological order of the statement graph which places each
+   * statement as close as possible to the statements that compute its arguments. From all statements whose arguments
+   * are available, the one with the most recently placed argument is taken next. The inputs are registered right
+   * before their first use.
+   *
+   * The statements are then recorded in the new order on a second tape. The linear index handler of the new tape
+   * numbers the indices in the new order, so that the arguments of a statement are close to its lhs index. The
+   * helper provides the translation from the old to the new indices for the seeding and the reading of the adjoints.
+   *
+   * \code{.cpp}
+   *   codi::TapeReorderHelper<codi::RealReverse::TapeType> reorder(tape);
+   *
+   *   codi::RealReverse::TapeType newTape;
+   *   reorder.record(newTape);
+   *
+   *   int yIndex = reorder.translateIndex(y.getGradientData());
+   *   newTape.setGradient(yIndex, 1.0);
+   *   newTape.evaluate();
+   *   double xAdj = newTape.getGradient(reorder.translateIndex(x.getGradientData()));
+   * \endcode
+   *
+   * The reordering requires that each index is written only once in the recorded range, which is the case for tapes
+   * with a linear index handler. External functions are not part of the statement graph and are not recorded.
+   *
+   * @tparam Tape  A Jacobi tape with a linear index handler which implements forEachStatement.
+   */
+  template<typename Tape>
+  struct TapeReorderHelper {
+
+      typedef typename Tape::Real Real; /**< The floating point calculation type of the tape */
+      typedef typename Tape::Index Index; /**< The index type of the tape */
+      typedef typename Tape::Position Position; /**< The position type of the tape */
+
+    private:
+
+      TapeGraph<Tape> graph; /**< The statements of the original tape */
+      std::vector<size_t> order; /**< The statements of the graph in the new order */
+      std::vector<Index> indexMap; /**< The new index for each old index, zero if the index is not recorded */
+
+    public:
+
+      /**
+       * @brief Compute the new order for all statements of the tape.
+       *
+       * @param[in] tape  The recorded tape.
+       */
+      explicit TapeReorderHelper(Tape& tape) :
+        graph(tape),
+        order(),
+        indexMap() {
+        computeOrder();
+      }
+
+      /**
+       * @brief Compute the new order for a range of the tape.
+       *
+       * @param[in]  tape  The recorded tape.
+       * @param[in] start  The start of the range.
+       * @param[in]   end  The end of the range.
+       */
+      TapeReorderHelper(Tape& tape, const Position& start, const Position& end) :
+        graph(tape, start, end),
+        order(),
+        indexMap() {
+        computeOrder();
+      }
+
+      /**
+       * @brief Compute the new order for the statements of a graph.
+       *
+       * The graph can be created from a tape or be the result of a simplification pass.
+       *
+       * @param[in] graph  The statement graph.
+       */
+      explicit TapeReorderHelper(const TapeGraph<Tape>& graph) :
+        graph(graph),
+        order(),
+        indexMap() {
+        computeOrder();
+      }
+
+      /**
+       * @brief The statements of the original range in the new order.
+       *
+       * @return The statement numbers of the original range.
+       */
+      const std::vector<size_t>& getOrder() const {
+        return order;
+      }
+
+      /**
+       * @brief Record the statements in the new order on the given tape.
+       *
+       * The statements are appended to the tape. The translation of the indices is updated.
+       *
+       * @param[in,out] newTape  The tape that receives the statements. It has to be a different tape than the original
+       *                         one.
+       */
+      void record(Tape& newTape) {
+        indexMap.assign(getMaximumIndex() + 1, Index(0));
+
+        const bool wasActive = newTape.isActive();
+        newTape.setActive();
+
+        for(size_t pos = 0; pos < order.size(); ++pos) {
+          const size_t stmt = order[pos];
+
+          for(size_t arg = graph.argumentOffsets[stmt]; arg < graph.argumentOffsets[stmt + 1]; ++arg) {
+            Index& newIndex = indexMap[graph.argumentIndices[arg]];
+            if(0 == newIndex) {
+              newTape.registerManualInput(newIndex);
+            }
+          }
+
+          Index lhsIndex = Index(0);
+          newTape.storeManual(Real(), lhsIndex, (StatementInt)(graph.argumentOffsets[stmt + 1] - graph.argumentOffsets[stmt]));
+          for(size_t arg = graph.argumentOffsets[stmt]; arg < graph.argumentOffsets[stmt + 1]; ++arg) {
+            newTape.pushJacobiManual(graph.jacobies[arg], Real(), indexMap[graph.argumentIndices[arg]]);
+          }
+
+          indexMap[graph.lhsIndices[stmt]] = lhsIndex;
+        }
+
+        if(!wasActive) {
+          newTape.setPassive();
+        }
+      }
+
+      /**
+       * @brief Translate an index of the original tape into the index on the new tape.
+       *
+       * Only valid after record was called.
+       *
+       * @param[in] index  The index on the original tape.
+       *
+       * @return The index on the new tape or zero if the index is not used in the recorded range.
+       */
+      Index translateIndex(const Index& index) const {
+        if((size_t)index < indexMap.size()) {
+          return indexMap[index];
+        } else {
+          return Index(0);
+        }
+      }
+
+    private:
+
+      /**
+       * @brief The largest index that is used in the graph.
+       *
+       * @return The maximum over all lhs and argument indices.
+       */
+      Index getMaximumIndex() const {
+        Index maximum = Index(0);
+        if(0 != graph.lhsIndices.size()) {
+          maximum = std::max(maximum, *std::max_element(graph.lhsIndices.begin(), graph.lhsIndices.end()));
+        }
+        if(0 != graph.argumentIndices.size()) {
+          maximum = std::max(maximum, *std::max_element(graph.argumentIndices.begin(), graph.argumentIndices.end()));
+        }
+
+        return maximum;
+      }
+
+      /**
+       * @brief Compute the topological order of the statements with a list scheduling of the statement graph.
+       *
+       * The priority of a statement is the new position of its most recently placed argument. Ties are resolved by
+       * the original order.
+       */
+      void computeOrder() {
+        if(graph.jacobies.size() != graph.argumentIndices.size()) {
+          CODI_EXCEPTION("The reordering requires a tape that stores the Jacobians of the statements.");
+        }
+
+        if(!graph.isSingleAssignment()) {
+          CODI_EXCEPTION("The reordering requires a tape where each index is written only once.");
+        }
+
+        const size_t statementCount = graph.getStatementCount();
+
+        // Consumers of each statement and the number of arguments that are not yet available.
+        std::vector<size_t> pending(statementCount, 0);
+        std::vector<size_t> consumerOffsets(statementCount + 1, 0);
+        for(size_t arg = 0; arg < graph.argumentStatements.size(); ++arg) {
+          const size_t source = graph.argumentStatements[arg];
+          if(TapeGraph<Tape>::InputArgument != source) {
+            consumerOffsets[source + 1] += 1;
+          }
+        }
+        for(size_t stmt = 0; stmt < statementCount; ++stmt) {
+          consumerOffsets[stmt + 1] += consumerOffsets[stmt];
+        }
+
+        std::vector<size_t> consumers(consumerOffsets.back());
+        std::vector<size_t> consumerFill(consumerOffsets.begin(), consumerOffsets.end() - 1);
+        for(size_t stmt = 0; stmt < statementCount; ++stmt) {
+          for(size_t arg = graph.argumentOffsets[stmt]; arg < graph.argumentOffsets[stmt + 1]; ++arg) {
+            const size_t source = graph.argumentStatements[arg];
+            if(TapeGraph<Tape>::InputArgument != source) {
+              consumers[consumerFill[source]++] = stmt;
+              pending[stmt] += 1;
+            }
+          }
+        }
+
+        // The priority is the position of the last placed argument plus one, the second entry prefers earlier statements.
+        typedef std::pair<size_t, size_t> Priority;
+        std::priority_queue<Priority> ready;
+        std::vector<size_t> priorities(statementCount, 0);
+        for(size_t stmt = 0; stmt < statementCount; ++stmt) {
+          if(0 == pending[stmt]) {
+            ready.push(Priority(0, statementCount - 1 - stmt));
+          }
+        }
+
+        order.clear();
+        order.reserve(statementCount);
+        while(!ready.empty()) {
+          const size_t stmt = statementCount - 1 - ready.top().second;
+          ready.pop();
+
+          order.push_back(stmt);
+          for(size_t cur = consumerOffsets[stmt]; cur < consumerOffsets[stmt + 1]; ++cur) {
+            const size_t consumer = consumers[cur];
+            priorities[consumer] = order.size();
+            pending[consumer] -= 1;
+            if(0 == pending[consumer]) {
+              ready.push(Priority(priorities[consumer], statementCount - 1 - consumer));
+            }
+          }
+        }
+      }
+  };
+}
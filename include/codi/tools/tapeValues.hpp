@@ -28,10 +28,11 @@
 
 #pragma once
 
+#include <cmath>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 #include <string>
-#include <sstream>
 #include <tuple>
 #include <vector>
 
@@ -79,6 +80,9 @@ namespace codi {
    *
    * The function #formatDefault can be use to provide a pretty print of the values. #formatHeader and #formatRow output
    * the values in a csv table.
+   *
+   * For a processing by other tools, #formatJson, #formatCsvHeader and #formatCsvRow output the values without any
+   * padding and with full precision.
    */
   class TapeValues {
     private:
@@ -163,6 +167,24 @@ namespace codi {
 
       }
 
+      /**
+       * @brief Get the total used memory of all entries that were added with usedMem = true.
+       *
+       * @return The used memory in MB.
+       */
+      double getUsedMemorySize() const {
+        return doubleData[usedMemoryIndex];
+      }
+
+      /**
+       * @brief Get the total allocated memory of all entries that were added with allocatedMem = true.
+       *
+       * @return The allocated memory in MB.
+       */
+      double getAllocatedMemorySize() const {
+        return doubleData[allocatedMemoryIndex];
+      }
+
       /**
        * @brief Output the default format.
        *
@@ -280,6 +302,183 @@ namespace codi {
         out << "\n";
       }
 
+      /**
+       * @brief Output the values as a JSON object.
+       *
+       * Each section is an object in the "sections" array with the name of the section and its values. The memory
+       * values are given in MB. Values that are not finite are written as null, since JSON has no representation for
+       * them.
+       *
+       * \code{.txt}
+       * {"sections": [{"name": "Adjoint vector", "values": {"Number of adjoints": 14517, "Memory allocated": 0.11}}]}
+       * \endcode
+       *
+       * @param[in,out] out  The stream for the output.
+       *
+       * @tparam Stream  Needs to implement stream operations.
+       */
+      template<typename Stream = std::ostream>
+      void formatJson(Stream& out = std::cout) const {
+
+        out << "{\"sections\": [";
+        for(size_t i = 0; i < sections.size(); ++i) {
+          const ValueSection& section = sections[i];
+
+          if(0 != i) {
+            out << ", ";
+          }
+          out << "{\"name\": ";
+          formatJsonString(out, section.name);
+          out << ", \"values\": {";
+          for(size_t j = 0; j < section.data.size(); ++j) {
+            const Entry& data = section.data[j];
+
+            if(0 != j) {
+              out << ", ";
+            }
+            formatJsonString(out, std::get<0>(data));
+            out << ": ";
+            formatJsonValue(out, data);
+          }
+          out << "}}";
+        }
+        out << "]}";
+      }
+
+      /**
+       * @brief Output the header of a csv table with the given separator.
+       *
+       * The header are generated like: &lt;section name&gt;-&lt;value name&gt;
+       *
+       * In contrast to #formatHeader no spaces are added after the separator.
+       *
+       * @param[in,out]       out  The stream for the output.
+       * @param[in]     separator  The separator between the columns.
+       *
+       * @tparam Stream  Needs to implement stream operations.
+       */
+      template<typename Stream = std::ostream>
+      void formatCsvHeader(Stream& out = std::cout, const std::string& separator = ",") const {
+
+        bool first = true;
+        for(const ValueSection& section : sections) {
+          for(const Entry& data : section.data) {
+
+            if(first) {
+              first = false;
+            } else {
+              out << separator;
+            }
+            formatCsvString(out, section.name + "-" + std::get<0>(data), separator);
+          }
+        }
+
+        out << "\n";
+      }
+
+      /**
+       * @brief Output a data row of a csv table with the given separator.
+       *
+       * In contrast to #formatRow the values are not padded and the double values are written with full precision.
+       *
+       * @param[in,out]       out  The stream for the output.
+       * @param[in]     separator  The separator between the columns.
+       *
+       * @tparam Stream  Needs to implement stream operations.
+       */
+      template<typename Stream = std::ostream>
+      void formatCsvRow(Stream& out = std::cout, const std::string& separator = ",") const {
+
+        bool first = true;
+        for(const ValueSection& section : sections) {
+          for(const Entry& data : section.data) {
+
+            if(first) {
+              first = false;
+            } else {
+              out << separator;
+            }
+            formatExactValue(out, data);
+          }
+        }
+
+        out << "\n";
+      }
+
+      /**
+       * @brief Write a string as a JSON string with the necessary escape sequences.
+       *
+       * Control characters without a short escape sequence are written as \\u00XX.
+       *
+       * @param[in,out]  out  The stream for the output.
+       * @param[in]     text  The string to be written.
+       *
+       * @tparam Stream  Needs to implement stream operations.
+       */
+      template<typename Stream>
+      static void formatJsonString(Stream& out, const std::string& text) {
+        out << '"';
+        for(char c : text) {
+          switch (c) {
+          case '"':
+            out << "\\\"";
+            break;
+          case '\\':
+            out << "\\\\";
+            break;
+          case '\n':
+            out << "\\n";
+            break;
+          case '\t':
+            out << "\\t";
+            break;
+          case '\r':
+            out << "\\r";
+            break;
+          case '\b':
+            out << "\\b";
+            break;
+          case '\f':
+            out << "\\f";
+            break;
+          default:
+            if(static_cast<unsigned char>(c) < 0x20) {
+              const char* const hexDigits = "0123456789abcdef";
+              out << "\\u00" << hexDigits[(c >> 4) & 0xf] << hexDigits[c & 0xf];
+            } else {
+              out << c;
+            }
+            break;
+          }
+        }
+        out << '"';
+      }
+
+      /**
+       * @brief Write a string as a csv field. The field is quoted if it contains the separator, a quote or a line break.
+       *
+       * @param[in,out]       out  The stream for the output.
+       * @param[in]          text  The string to be written.
+       * @param[in]     separator  The separator between the columns.
+       *
+       * @tparam Stream  Needs to implement stream operations.
+       */
+      template<typename Stream>
+      static void formatCsvString(Stream& out, const std::string& text, const std::string& separator) {
+        if(std::string::npos == text.find(separator) && std::string::npos == text.find_first_of("\"\n\r")) {
+          out << text;
+        } else {
+          out << '"';
+          for(char c : text) {
+            if('"' == c) {
+              out << '"';
+            }
+            out << c;
+          }
+          out << '"';
+        }
+      }
+
       /**
        * @brief Helper function that combines the tape data on with an MPI_Allreduce on MPI_COMM_WORLD.
        */
@@ -320,6 +519,58 @@ namespace codi {
         }
       }
 
+      /**
+       * @brief Format a value without padding and with the full precision of its type.
+       *
+       * The format flags of the stream are restored afterwards.
+       *
+       * @param[in,out]  out  The stream for the output.
+       * @param[in]     data  The data to be formatted.
+       *
+       * @tparam Stream  Needs to implement stream operations.
+       */
+      template<typename Stream>
+      void formatExactValue(Stream& out, const Entry& data) const {
+        switch (std::get<1>(data)) {
+        case EntryType::Int:
+          out << intData[std::get<2>(data)];
+          break;
+        case EntryType::Double: {
+          std::ios::fmtflags flags = out.flags();
+          std::streamsize precision = out.precision();
+
+          out.unsetf(std::ios::floatfield);
+          out << std::setprecision(std::numeric_limits<double>::max_digits10) << doubleData[std::get<2>(data)];
+
+          out.flags(flags);
+          out.precision(precision);
+          break;
+        }
+        default:
+          CODI_EXCEPTION("Unimplemented switch case.");
+          break;
+        }
+      }
+
+      /**
+       * @brief Format a value as a JSON value.
+       *
+       * Double values that are not finite are written as null.
+       *
+       * @param[in,out]  out  The stream for the output.
+       * @param[in]     data  The data to be formatted.
+       *
+       * @tparam Stream  Needs to implement stream operations.
+       */
+      template<typename Stream>
+      void formatJsonValue(Stream& out, const Entry& data) const {
+        if(EntryType::Double == std::get<1>(data) && !std::isfinite(doubleData[std::get<2>(data)])) {
+          out << "null";
+        } else {
+          formatExactValue(out, data);
+        }
+      }
+
       /**
        * @brief Get an estimate how the long the string for the formatted data will be.
        *
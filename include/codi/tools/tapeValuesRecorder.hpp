@@ -0,0 +1,213 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../exceptions.hpp"
+#include "tapeValues.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Records a time series of tape values.
+   *
+   * Each call to #record stores the result of getTapeValues() of the tape together with a user defined label, e.g. the
+   * number of the time step. The snapshots are accumulated until #clear is called and can be written as a csv table
+   * with one row per snapshot or as a JSON array.
+   *
+   * All snapshots for a csv table need to have the same layout, that is they have to be taken from the same tape type.
+   *
+   * \code{.cpp}
+   *   TapeValuesRecorder recorder;
+   *   for(int step = 0; step < steps; ++step) {
+   *     ... // record the tape
+   *     recorder.record(tape, std::to_string(step));
+   *     ... // evaluate and reset the tape
+   *   }
+   *   recorder.writeCsv(std::cout);
+   * \endcode
+   */
+  class TapeValuesRecorder {
+    private:
+
+      /**
+       * @brief The values of one snapshot and its label.
+       */
+      struct Snapshot {
+        std::string label; /**< The user defined label */
+        TapeValues values; /**< The tape values at the time of the snapshot */
+
+        /**
+         * @brief Store the label and the values.
+         *
+         * @param[in]  label  The user defined label.
+         * @param[in] values  The tape values.
+         */
+        Snapshot(const std::string& label, const TapeValues& values) :
+          label(label),
+          values(values) {}
+      };
+
+      std::vector<Snapshot> snapshots; /**< All recorded snapshots */
+
+    public:
+
+      /**
+       * @brief Creates an empty recorder.
+       */
+      TapeValuesRecorder() :
+        snapshots() {}
+
+      /**
+       * @brief Store the current values of the tape.
+       *
+       * @param[in]  tape  The tape which provides the values.
+       * @param[in] label  The label for the snapshot.
+       *
+       * @tparam Tape  Needs to implement getTapeValues().
+       */
+      template<typename Tape>
+      void record(const Tape& tape, const std::string& label) {
+        recordValues(tape.getTapeValues(), label);
+      }
+
+      /**
+       * @brief Store already gathered tape values.
+       *
+       * @param[in] values  The tape values.
+       * @param[in]  label  The label for the snapshot.
+       */
+      void recordValues(const TapeValues& values, const std::string& label) {
+        snapshots.push_back(Snapshot(label, values));
+      }
+
+      /**
+       * @brief Remove all snapshots.
+       */
+      void clear() {
+        snapshots.clear();
+      }
+
+      /**
+       * @brief The number of recorded snapshots.
+       *
+       * @return The number of snapshots.
+       */
+      size_t getSnapshotCount() const {
+        return snapshots.size();
+      }
+
+      /**
+       * @brief Get the values of a snapshot.
+       *
+       * @param[in] pos  The number of the snapshot.
+       *
+       * @return The tape values of the snapshot.
+       */
+      const TapeValues& getValues(size_t pos) const {
+        return snapshots[pos].values;
+      }
+
+      /**
+       * @brief Get the label of a snapshot.
+       *
+       * @param[in] pos  The number of the snapshot.
+       *
+       * @return The label of the snapshot.
+       */
+      const std::string& getLabel(size_t pos) const {
+        return snapshots[pos].label;
+      }
+
+      /**
+       * @brief Write all snapshots as a csv table.
+       *
+       * The first column contains the label, the other columns are the ones from TapeValues::formatCsvHeader. The
+       * header is written for the first snapshot.
+       *
+       * @param[in,out]       out  The stream for the output.
+       * @param[in]     separator  The separator between the columns.
+       * @param[in]        header  If the header should be written.
+       *
+       * @tparam Stream  Needs to implement stream operations.
+       */
+      template<typename Stream = std::ostream>
+      void writeCsv(Stream& out = std::cout, const std::string& separator = ",", bool header = true) const {
+        if(snapshots.empty()) {
+          return;
+        }
+
+        if(header) {
+          out << "Label" << separator;
+          snapshots.front().values.formatCsvHeader(out, separator);
+        }
+
+        for(const Snapshot& snapshot : snapshots) {
+          TapeValues::formatCsvString(out, snapshot.label, separator);
+          out << separator;
+          snapshot.values.formatCsvRow(out, separator);
+        }
+      }
+
+      /**
+       * @brief Write all snapshots as a JSON array.
+       *
+       * Each element contains the label and the output of TapeValues::formatJson.
+       *
+       * \code{.txt}
+       * [{"label": "0", "values": {"sections": [...]}}, ...]
+       * \endcode
+       *
+       * @param[in,out] out  The stream for the output.
+       *
+       * @tparam Stream  Needs to implement stream operations.
+       */
+      template<typename Stream = std::ostream>
+      void writeJson(Stream& out = std::cout) const {
+        out << "[";
+        for(size_t i = 0; i < snapshots.size(); ++i) {
+          if(0 != i) {
+            out << ",\n ";
+          }
+          out << "{\"label\": ";
+          TapeValues::formatJsonString(out, snapshots[i].label);
+          out << ", \"values\": ";
+          snapshots[i].values.formatJson(out);
+          out << "}";
+        }
+        out << "]\n";
+      }
+  };
+}
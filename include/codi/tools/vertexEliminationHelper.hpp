@@ -0,0 +1,561 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../configure.h"
+#include "../exceptions.hpp"
+#include "tapeGraph.hpp"
+
+/**
+ * @brief Global namespace for CoDiPack - Code Differentiation Package
+ */
+namespace codi {
+
+  /**
+   * @brief Computes the Jacobian of a statement graph by vertex elimination.
+   *
+   * The statement graph of a Jacobi tape is the linearized computational graph of the recorded code. The Jacobian
+   * of the outputs with respect to the inputs is computed by eliminating all intermediate vertices. The elimination
+   * of a vertex \f$ v \f$ adds for every predecessor \f$ p \f$ and every successor \f$ s \f$ the product of the edge
+   * weights to the edge from \f$ p \f$ to \f$ s \f$:
+   * \f[ c_{s,p} += c_{s,v} \cdot c_{v,p} \f]
+   *
+   * The vertices are eliminated in the Markowitz order, the vertex with the smallest product of the number of
+   * predecessors and successors is eliminated first. Statements that do not contribute to an output are not
+   * considered. For graphs with many inputs and outputs, this requires fewer multiplications than one forward or
+   * reverse sweep for each input or output.
+   *
+   * The elimination is compiled into a list of multiply-add operations on the edge values. The compiled program only
+   * depends on the structure of the graph. A region of a tape with the same structure can therefore be evaluated with
+   * evaluateRecorded, which reads only the Jacobians from the tape and executes the program.
+   *
+   * \code{.cpp}
+   *   codi::VertexEliminationHelper<codi::RealReverse::TapeType> elimination;
+   *   elimination.computeJacobian(graph, inputIndices, nInputs, outputIndices, nOutputs, jacobian);
+   *
+   *   // Same code for different data.
+   *   if(!elimination.evaluateRecorded(tape, start, end, inputIndices, nInputs, outputIndices, nOutputs, jacobian)) {
+   *     // Structure differs, create the graph and call computeJacobian.
+   *   }
+   * \endcode
+   *
+   * @tparam Tape  A Jacobi tape which implements forEachStatement.
+   */
+  template<typename Tape>
+  struct VertexEliminationHelper {
+
+      typedef typename Tape::Real Real; /**< The floating point calculation type of the tape */
+      typedef typename Tape::Index Index; /**< The index type of the tape */
+      typedef typename Tape::Position Position; /**< The position type of the tape */
+
+    private:
+
+      /** @brief Marker for arguments and entries without an edge. */
+      static const size_t NoEdge = std::numeric_limits<size_t>::max();
+
+      /** @brief The edge with the constant value one. */
+      static const size_t OneEdge = 0;
+
+      /** @brief The update of the edge values target += first * second. */
+      struct Operation {
+          size_t target; /**< The updated edge */
+          size_t first; /**< The first factor */
+          size_t second; /**< The second factor */
+      };
+
+      /** @brief The edges of one vertex, the key is the connected vertex, the value the edge. */
+      typedef std::unordered_map<size_t, size_t> EdgeMap;
+
+      std::vector<EdgeMap> predecessors; /**< The incoming edges of each vertex during the compilation */
+      std::vector<EdgeMap> successors; /**< The outgoing edges of each vertex during the compilation */
+
+      size_t statementCount; /**< The number of statements of the compiled graph */
+      size_t inputSize; /**< The number of inputs of the compiled graph */
+      size_t outputSize; /**< The number of outputs of the compiled graph */
+      std::vector<size_t> firstInputs; /**< For each input the position of the first input with the same index */
+      std::vector<size_t> argumentOffsets; /**< The start of the arguments of each statement */
+      std::vector<size_t> argumentSources; /**< The statement or statementCount + input position of each argument */
+      std::vector<size_t> argumentEdges; /**< The edge of each argument or NoEdge if it is not used */
+      std::vector<size_t> outputSources; /**< The statement or statementCount + input position of each output */
+      std::vector<size_t> jacobianEdges; /**< The edge of each entry of the Jacobian or NoEdge for zero entries */
+      std::vector<Operation> operations; /**< The compiled elimination */
+      size_t edgeCount; /**< The number of edges including the fill in */
+
+      std::vector<Real> edgeValues; /**< The values of the edges during the evaluation */
+      std::vector<Real> recordedJacobies; /**< The Jacobians that are read from the tape */
+      std::vector<Index> recordedLhs; /**< The lhs indices that are read from the tape */
+      std::unordered_map<Index, size_t> inputPositions; /**< The first position of each input index */
+
+    public:
+
+      /**
+       * @brief Create an empty helper.
+       */
+      VertexEliminationHelper() :
+        predecessors(),
+        successors(),
+        statementCount(0),
+        inputSize(0),
+        outputSize(0),
+        firstInputs(),
+        argumentOffsets(),
+        argumentSources(),
+        argumentEdges(),
+        outputSources(),
+        jacobianEdges(),
+        operations(),
+        edgeCount(0),
+        edgeValues(),
+        recordedJacobies(),
+        recordedLhs(),
+        inputPositions() {}
+
+      /**
+       * @brief The number of multiply-add operations of the compiled elimination.
+       *
+       * @return The number of operations.
+       */
+      size_t getOperationCount() const {
+        return operations.size();
+      }
+
+      /**
+       * @brief Compile the elimination for the graph and compute the Jacobian of the outputs with respect to the inputs.
+       *
+       * An output is the value of the last statement in the graph that writes the output index. If no statement
+       * writes the index, the derivative is the identity if the output is also an input. Arguments of the graph that
+       * are not in the list of the inputs are treated as passive values.
+       *
+       * @param[in]    graph  The statement graph of a Jacobi tape.
+       * @param[in]   inputs  The indices of the inputs.
+       * @param[in]      nIn  The number of inputs.
+       * @param[in]  outputs  The indices of the outputs.
+       * @param[in]     nOut  The number of outputs.
+       * @param[out] jacobie  The Jacobian, the entry for input i and output j is stored at i + j * nIn.
+       */
+      void computeJacobian(const TapeGraph<Tape>& graph, const Index* inputs, size_t nIn, const Index* outputs,
+                           size_t nOut, Real* jacobie) {
+        if(graph.jacobies.size() != graph.argumentIndices.size()) {
+          CODI_EXCEPTION("The vertex elimination requires a tape that stores the Jacobians of the statements.");
+        }
+
+        compile(graph, inputs, nIn, outputs, nOut);
+        evaluate(graph.jacobies.data(), jacobie);
+      }
+
+      /**
+       * @brief Compute the Jacobian of a tape region with the compiled elimination.
+       *
+       * The Jacobians are read from the tape and the structure of the region is compared with the compiled graph. No
+       * graph is created. The check of the structure requires that the statements of the region write new indices in
+       * increasing order, which is the case for the linear index handler. Other regions are rejected. The inputs need
+       * to be duplicated at the same positions as for the compiled graph.
+       *
+       * @param[in,out] tape  The tape with the recorded region.
+       * @param[in]    start  The start of the region.
+       * @param[in]      end  The end of the region.
+       * @param[in]   inputs  The indices of the inputs.
+       * @param[in]      nIn  The number of inputs.
+       * @param[in]  outputs  The indices of the outputs.
+       * @param[in]     nOut  The number of outputs.
+       * @param[out] jacobie  The Jacobian, the entry for input i and output j is stored at i + j * nIn.
+       *
+       * @return False if nothing is compiled or the structure of the region differs. The Jacobian is not computed in
+       *         this case.
+       */
+      bool evaluateRecorded(Tape& tape, const Position& start, const Position& end, const Index* inputs, size_t nIn,
+                            const Index* outputs, size_t nOut, Real* jacobie) {
+        if(nIn != inputSize || nOut != outputSize || argumentOffsets.empty()) {
+          return false;
+        }
+
+        inputPositions.clear();
+        for(size_t in = 0; in < nIn; ++in) {
+          if(firstInputs[in] != inputPositions.insert(std::make_pair(inputs[in], in)).first->second) {
+            return false;
+          }
+        }
+
+        recordedJacobies.resize(argumentSources.size());
+        recordedLhs.resize(statementCount);
+
+        Index maximumInput = Index();
+        for(size_t in = 0; in < nIn; ++in) {
+          if(0 == in || maximumInput < inputs[in]) {
+            maximumInput = inputs[in];
+          }
+        }
+
+        bool matches = true;
+        size_t stmt = 0;
+        tape.forEachStatement(start, end, [&] (const Index& lhsIndex, size_t nArgs, const Index* indices,
+                                               const Real* argJacobies, const char* operation) {
+          CODI_UNUSED(operation);
+
+          if(!matches || stmt >= statementCount || NULL == argJacobies ||
+             nArgs != argumentOffsets[stmt + 1] - argumentOffsets[stmt]) {
+            matches = false;
+            return;
+          }
+
+          // Only regions that write new indices in increasing order are accepted, then no statement overwrites an
+          // input or the result of another statement.
+          if(0 == stmt ? (0 != nIn && lhsIndex <= maximumInput) : lhsIndex <= recordedLhs[stmt - 1]) {
+            matches = false;
+            return;
+          }
+
+          const size_t offset = argumentOffsets[stmt];
+          for(size_t i = 0; i < nArgs; ++i) {
+            if(!this->isSource(argumentSources[offset + i], indices[i], stmt, inputs)) {
+              matches = false;
+              return;
+            }
+            recordedJacobies[offset + i] = argJacobies[i];
+          }
+
+          recordedLhs[stmt] = lhsIndex;
+          stmt += 1;
+        });
+
+        matches &= stmt == statementCount;
+        for(size_t out = 0; matches && out < nOut; ++out) {
+          matches = isSource(outputSources[out], outputs[out], stmt, inputs);
+        }
+
+        if(matches) {
+          evaluate(recordedJacobies.data(), jacobie);
+        }
+
+        return matches;
+      }
+
+    private:
+
+      /**
+       * @brief Check if the index matches the compiled source of an argument or an output.
+       *
+       * A passive argument must neither be an input nor the result of one of the recorded statements.
+       *
+       * @param[in]    source  The compiled source.
+       * @param[in]     index  The index on the tape.
+       * @param[in] statement  The number of statements that are already recorded.
+       * @param[in]    inputs  The indices of the inputs.
+       *
+       * @return True if the index is written by the same statement or is the same input as in the compiled graph.
+       */
+      bool isSource(size_t source, const Index& index, size_t statement, const Index* inputs) const {
+        if(source < statementCount) {
+          return recordedLhs[source] == index;
+        } else if(NoEdge != source) {
+          return inputs[source - statementCount] == index;
+        } else {
+          for(size_t in = 0; in < inputSize; ++in) {
+            if(inputs[in] == index) {
+              return false;
+            }
+          }
+
+          return !std::binary_search(recordedLhs.begin(), recordedLhs.begin() + statement, index);
+        }
+      }
+
+      /**
+       * @brief Execute the compiled elimination.
+       *
+       * @param[in]  argJacobies  The Jacobians of the arguments in the order of the graph.
+       * @param[out]     jacobie  The Jacobian of the outputs with respect to the inputs.
+       */
+      void evaluate(const Real* argJacobies, Real* jacobie) {
+        edgeValues.assign(edgeCount, Real());
+        edgeValues[OneEdge] = 1.0;
+
+        for(size_t arg = 0; arg < argumentEdges.size(); ++arg) {
+          if(NoEdge != argumentEdges[arg]) {
+            edgeValues[argumentEdges[arg]] += argJacobies[arg];
+          }
+        }
+
+        for(size_t pos = 0; pos < operations.size(); ++pos) {
+          const Operation& op = operations[pos];
+          edgeValues[op.target] += edgeValues[op.first] * edgeValues[op.second];
+        }
+
+        for(size_t pos = 0; pos < jacobianEdges.size(); ++pos) {
+          jacobie[pos] = NoEdge == jacobianEdges[pos] ? Real() : edgeValues[jacobianEdges[pos]];
+        }
+      }
+
+      /**
+       * @brief Get the edge between two vertices, a new edge is created if it does not exist.
+       *
+       * @param[in] from  The source vertex.
+       * @param[in]   to  The target vertex.
+       *
+       * @return The edge.
+       */
+      size_t getEdge(size_t from, size_t to) {
+        std::pair<EdgeMap::iterator, bool> entry = successors[from].insert(std::make_pair(to, edgeCount));
+        if(entry.second) {
+          predecessors[to][from] = edgeCount;
+          edgeCount += 1;
+        }
+
+        return entry.first->second;
+      }
+
+      /**
+       * @brief Compile the elimination of the graph.
+       *
+       * @param[in]   graph  The statement graph of a Jacobi tape.
+       * @param[in]  inputs  The indices of the inputs.
+       * @param[in]     nIn  The number of inputs.
+       * @param[in] outputs  The indices of the outputs.
+       * @param[in]    nOut  The number of outputs.
+       */
+      void compile(const TapeGraph<Tape>& graph, const Index* inputs, size_t nIn, const Index* outputs, size_t nOut) {
+        statementCount = graph.getStatementCount();
+        inputSize = nIn;
+        outputSize = nOut;
+        argumentOffsets = graph.argumentOffsets;
+        operations.clear();
+        edgeCount = OneEdge + 1;
+
+        // Vertices are the statements followed by the inputs.
+        std::unordered_map<Index, size_t> inputVertices;
+        firstInputs.resize(nIn);
+        for(size_t in = 0; in < nIn; ++in) {
+          firstInputs[in] = inputVertices.insert(std::make_pair(inputs[in], statementCount + in)).first->second -
+                            statementCount;
+        }
+
+        argumentSources.resize(graph.getArgumentCount());
+        for(size_t arg = 0; arg < graph.getArgumentCount(); ++arg) {
+          argumentSources[arg] = graph.argumentStatements[arg];
+          if(TapeGraph<Tape>::InputArgument == argumentSources[arg]) {
+            typename std::unordered_map<Index, size_t>::const_iterator input = inputVertices.find(graph.argumentIndices[arg]);
+            argumentSources[arg] = inputVertices.end() == input ? NoEdge : input->second;
+          }
+        }
+
+        std::unordered_map<Index, size_t> lastWriter;
+        for(size_t stmt = 0; stmt < statementCount; ++stmt) {
+          lastWriter[graph.lhsIndices[stmt]] = stmt;
+        }
+
+        std::vector<bool> isOutput(statementCount, false);
+        std::vector<bool> isRelevant(statementCount, false);
+        outputSources.resize(nOut);
+        for(size_t out = 0; out < nOut; ++out) {
+          typename std::unordered_map<Index, size_t>::const_iterator writer = lastWriter.find(outputs[out]);
+          if(lastWriter.end() != writer) {
+            outputSources[out] = writer->second;
+            isOutput[writer->second] = true;
+            isRelevant[writer->second] = true;
+          } else {
+            typename std::unordered_map<Index, size_t>::const_iterator input = inputVertices.find(outputs[out]);
+            outputSources[out] = inputVertices.end() == input ? NoEdge : input->second;
+          }
+        }
+
+        for(size_t stmt = statementCount; stmt > 0; --stmt) {
+          if(isRelevant[stmt - 1]) {
+            for(size_t arg = argumentOffsets[stmt - 1]; arg < argumentOffsets[stmt]; ++arg) {
+              if(argumentSources[arg] < statementCount) {
+                isRelevant[argumentSources[arg]] = true;
+              }
+            }
+          }
+        }
+
+        // Create the edges of all statements that contribute to an output.
+        predecessors.assign(statementCount + nIn, EdgeMap());
+        successors.assign(statementCount + nIn, EdgeMap());
+        argumentEdges.assign(graph.getArgumentCount(), NoEdge);
+        for(size_t stmt = 0; stmt < statementCount; ++stmt) {
+          if(isRelevant[stmt]) {
+            for(size_t arg = argumentOffsets[stmt]; arg < argumentOffsets[stmt + 1]; ++arg) {
+              if(NoEdge != argumentSources[arg]) {
+                argumentEdges[arg] = getEdge(argumentSources[arg], stmt);
+              }
+            }
+          }
+        }
+
+        eliminateIntermediates(isOutput, isRelevant);
+
+        // Accumulate the outputs in the recorded order, outputs may depend on other outputs.
+        std::unordered_map<size_t, std::vector<size_t> > rows;
+        for(size_t stmt = 0; stmt < statementCount; ++stmt) {
+          if(isOutput[stmt]) {
+            std::vector<size_t>& row = rows[stmt];
+            row.assign(nIn, NoEdge);
+            for(EdgeMap::const_iterator edge = predecessors[stmt].begin(); edge != predecessors[stmt].end(); ++edge) {
+              if(edge->first >= statementCount) {
+                addRowOperation(row[edge->first - statementCount], edge->second, OneEdge);
+              } else {
+                const std::vector<size_t>& sourceRow = rows[edge->first];
+                for(size_t in = 0; in < nIn; ++in) {
+                  if(NoEdge != sourceRow[in]) {
+                    addRowOperation(row[in], edge->second, sourceRow[in]);
+                  }
+                }
+              }
+            }
+          }
+        }
+
+        jacobianEdges.assign(nIn * nOut, NoEdge);
+        for(size_t out = 0; out < nOut; ++out) {
+          if(outputSources[out] < statementCount) {
+            const std::vector<size_t>& row = rows[outputSources[out]];
+            for(size_t in = 0; in < nIn; ++in) {
+              jacobianEdges[in + out * nIn] = row[in];
+            }
+          } else if(NoEdge != outputSources[out]) {
+            jacobianEdges[outputSources[out] - statementCount + out * nIn] = OneEdge;
+          }
+        }
+
+        predecessors.clear();
+        successors.clear();
+      }
+
+      /**
+       * @brief Add the operation entry += first * second for an entry of an output row.
+       *
+       * @param[in,out] entry  The edge of the row entry, it is created if it is NoEdge.
+       * @param[in]     first  The first factor.
+       * @param[in]    second  The second factor.
+       */
+      void addRowOperation(size_t& entry, size_t first, size_t second) {
+        if(NoEdge == entry) {
+          entry = edgeCount;
+          edgeCount += 1;
+        }
+
+        operations.push_back(Operation{entry, first, second});
+      }
+
+      /**
+       * @brief The Markowitz degree of a vertex.
+       *
+       * @param[in] vertex  The vertex in the graph.
+       *
+       * @return The number of predecessors times the number of successors.
+       */
+      size_t markowitzDegree(size_t vertex) const {
+        return predecessors[vertex].size() * successors[vertex].size();
+      }
+
+      /**
+       * @brief Add the statement vertices of the edges which are not outputs to the queue with their current degree.
+       *
+       * @param[in,out] queue  The elimination queue.
+       * @param[in]     edges  The edges of an eliminated vertex.
+       * @param[in]  isOutput  True for the statements that compute an output.
+       *
+       * @tparam Queue  The type of the priority queue.
+       */
+      template<typename Queue>
+      void queueNeighbors(Queue& queue, const EdgeMap& edges, const std::vector<bool>& isOutput) const {
+        for(EdgeMap::const_iterator edge = edges.begin(); edge != edges.end(); ++edge) {
+          if(edge->first < isOutput.size() && !isOutput[edge->first]) {
+            queue.push(std::make_pair(markowitzDegree(edge->first), edge->first));
+          }
+        }
+      }
+
+      /**
+       * @brief Eliminate all relevant statements which are not outputs.
+       *
+       * The vertices are kept in a priority queue. The neighbors of an eliminated vertex are added again with their
+       * new degree, the outdated entries are skipped.
+       *
+       * @param[in]   isOutput  True for the statements that compute an output.
+       * @param[in] isRelevant  True for the statements that contribute to an output.
+       */
+      void eliminateIntermediates(const std::vector<bool>& isOutput, const std::vector<bool>& isRelevant) {
+        typedef std::pair<size_t, size_t> Entry;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+
+        for(size_t stmt = 0; stmt < isOutput.size(); ++stmt) {
+          if(isRelevant[stmt] && !isOutput[stmt]) {
+            queue.push(Entry(markowitzDegree(stmt), stmt));
+          }
+        }
+
+        std::vector<bool> eliminated(isOutput.size(), false);
+        while(!queue.empty()) {
+          const Entry entry = queue.top();
+          queue.pop();
+
+          const size_t vertex = entry.second;
+          if(eliminated[vertex] || markowitzDegree(vertex) != entry.first) {
+            continue; // Outdated entry, the neighbors are queued again after each elimination.
+          }
+
+          for(EdgeMap::const_iterator pred = predecessors[vertex].begin(); pred != predecessors[vertex].end(); ++pred) {
+            successors[pred->first].erase(vertex);
+          }
+          for(EdgeMap::const_iterator succ = successors[vertex].begin(); succ != successors[vertex].end(); ++succ) {
+            predecessors[succ->first].erase(vertex);
+          }
+
+          for(EdgeMap::const_iterator pred = predecessors[vertex].begin(); pred != predecessors[vertex].end(); ++pred) {
+            for(EdgeMap::const_iterator succ = successors[vertex].begin(); succ != successors[vertex].end(); ++succ) {
+              const size_t target = getEdge(pred->first, succ->first);
+              operations.push_back(Operation{target, succ->second, pred->second});
+            }
+          }
+
+          eliminated[vertex] = true;
+          queueNeighbors(queue, predecessors[vertex], isOutput);
+          queueNeighbors(queue, successors[vertex], isOutput);
+
+          EdgeMap().swap(predecessors[vertex]);
+          EdgeMap().swap(successors[vertex]);
+        }
+      }
+  };
+
+  template<typename Tape>
+  const size_t VertexEliminationHelper<Tape>::NoEdge;
+
+  template<typename Tape>
+  const size_t VertexEliminationHelper<Tape>::OneEdge;
+}
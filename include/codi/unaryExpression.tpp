@@ -40,6 +40,12 @@
  * The user needs to define the following functions:
  *
  * gradNAME: Computes the derivative df(x)/dx for y = f(x)
+ *
+ * Optionally the user can define the preprocessor macro VALUE_GRADIENT_FUNCTION. It is the name of a function
+ * f(x, y, dy) that computes the value y = f(x) and the derivative dy = df(x)/dx together. It is used in the tangent
+ * evaluation of the primal value tapes, where both are required. This can be used if the derivative requires a second
+ * transcendental function of the same argument, e.g. a sincos kernel for sin and cos. The expression itself still
+ * computes the derivative only when it is needed in calcGradient.
  */
 
 #ifndef NAME
@@ -58,6 +64,9 @@
 #define FUNC FUNCTION
 #define PRIMAL_CALL PRIMAL_FUNCTION
 #define GRADIENT_FUNC   COMBINE(gradient_, NAME)
+#ifdef VALUE_GRADIENT_FUNCTION
+  #define VALUE_GRADIENT_CALL VALUE_GRADIENT_FUNCTION
+#endif
 
 /* predefine the struct and the function for higher order derivatives */
 template<typename Real, class A> struct OP;
@@ -235,9 +244,16 @@ struct OP : public Expression<Real, OP<Real, A> > {
   template<typename Index, typename GradientValue, size_t offset, size_t constantOffset>
   static CODI_INLINE Real evalTangent(const Real& seed, GradientValue& lhsAdjoint, const Index* indices, const PassiveReal* constantValues, const Real* primalValues, PRIMAL_ADJOINT_TYPE* adjointValues) {
     const Real aPrimal = A::template getValue<Index, offset, constantOffset>(indices, constantValues, primalValues);
+#ifdef VALUE_GRADIENT_CALL
+    Real resPrimal;
+    Real gradient;
+    VALUE_GRADIENT_CALL(aPrimal, resPrimal, gradient);
+#else
     const Real resPrimal = PRIMAL_CALL(aPrimal);
+    const Real gradient = GRADIENT_FUNC(aPrimal, resPrimal);
+#endif
 
-    const Real aJac = GRADIENT_FUNC(aPrimal, resPrimal) * seed;
+    const Real aJac = gradient * seed;
     A::template evalTangent<Index, GradientValue, offset, constantOffset>(aJac, lhsAdjoint, indices, constantValues, primalValues, adjointValues);
 
     return resPrimal;
@@ -323,6 +339,10 @@ CODI_INLINE OP<Real, A> FUNC(const Expression<Real, A>& a) {
 #undef FUNC
 #undef PRIMAL_CALL
 #undef GRADIENT_FUNC
+#ifdef VALUE_GRADIENT_CALL
+  #undef VALUE_GRADIENT_CALL
+  #undef VALUE_GRADIENT_FUNCTION
+#endif
 
 #undef PRIMAL_FUNCTION
 #undef FUNCTION
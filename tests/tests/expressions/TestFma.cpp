@@ -0,0 +1,50 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#include <toolDefines.h>
+
+#include <cmath>
+
+IN(3)
+OUT(4)
+POINTS(2) =
+{
+  {0.1, 10.0 / 3.0, -1.0 / 3.0},
+  {2.0, -3.0, 5.0}
+};
+
+void func(NUMBER* x, NUMBER* y) {
+  y[0] = fma(x[0], x[1], x[2]);
+  y[1] = fma(x[0] * x[1], x[1], exp(x[2]));
+  y[2] = fma(x[0], 2.0, 3.0) * fma(2.0, 3.0, x[2]);
+
+  // The value has to be rounded only once, the check is passed as a passive factor.
+  double fused = std::fma(codi::TypeTraits<NUMBER>::getBaseValue(x[0]),
+                          codi::TypeTraits<NUMBER>::getBaseValue(x[1]),
+                          codi::TypeTraits<NUMBER>::getBaseValue(x[2]));
+  y[3] = x[0] * (fused == codi::TypeTraits<NUMBER>::getBaseValue(y[0]) ? 1.0 : 0.0);
+}
@@ -0,0 +1,161 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+IN(3)
+OUT(1)
+POINTS(2) = {{1.0, 2.0, 0.5}, {-0.5, 0.25, 1.5}};
+
+typedef NUMBER::TapeType Tape;
+
+/*
+ * The helper works only on Jacobi tapes with a linear index handler. For all other tapes, the test uses the reverse
+ * evaluation of the tape, such that the output is the same for all drivers.
+ */
+template<typename T>
+auto linearJacobiTag(T* tape) -> decltype(tape->registerManualInput(std::declval<typename T::Index&>()),
+                                          std::integral_constant<bool, T::LinearIndexHandler>());
+std::false_type linearJacobiTag(...);
+
+typedef decltype(linearJacobiTag((Tape*)NULL)) IsLinearJacobiTape;
+
+template<typename T>
+const T& firstDirection(const T& value) {
+  return value;
+}
+
+template<typename T, size_t n>
+const T& firstDirection(const codi::Direction<T, n>& value) {
+  return value[0];
+}
+
+/*
+ * Three independent chains of single argument statements which are recorded interleaved.
+ */
+void recordFunction(NUMBER* x, NUMBER& w) {
+  NUMBER a = x[0];
+  NUMBER b = x[1];
+  NUMBER c = x[2];
+  for(int i = 0; i < 6; ++i) {
+    a = 1.5 * sin(a);
+    b = cos(b) + 0.5;
+    c = 0.8 * exp(-c);
+  }
+  w = a * b + c;
+}
+
+std::vector<double> evaluateTape(Tape& tape, const Tape::Position& start, const Tape::Position& end, NUMBER* x, NUMBER& w) {
+  w.setGradient(1.0);
+  tape.evaluate(end, start);
+
+  std::vector<double> gradient(3);
+  for(size_t i = 0; i < gradient.size(); ++i) {
+    gradient[i] = codi::TypeTraits<Tape::Real>::getBaseValue(firstDirection(x[i].getGradient()));
+  }
+  tape.clearAdjoints();
+
+  return gradient;
+}
+
+bool isEqual(const std::vector<double>& a, const std::vector<double>& b) {
+  bool equal = a.size() == b.size();
+  for(size_t i = 0; equal && i < a.size(); ++i) {
+    equal = std::abs(a[i] - b[i]) <= 1e-12 * std::max(1.0, std::abs(b[i]));
+  }
+
+  return equal;
+}
+
+void printGradient(const std::vector<double>& gradient) {
+  std::cout << "Gradient:";
+  for(double value : gradient) {
+    std::cout << " " << value;
+  }
+  std::cout << std::endl;
+}
+
+template<typename T>
+std::vector<double> evaluateEliminated(T& tape, const typename T::Position& start, const typename T::Position& end,
+                                       NUMBER* x, NUMBER& w, bool& eliminated, std::true_type) {
+  // All statements of the chains and the copies of the inputs are folded into the last statement.
+  codi::ChainEliminationHelper<T> elimination;
+  codi::TapeGraph<T> graph = elimination.eliminate(codi::TapeGraph<T>(tape, start, end));
+  eliminated = 1 == graph.getStatementCount() && 3 == graph.getArgumentCount();
+
+  codi::TapeReorderHelper<T> reorder(graph);
+
+  T newTape;
+  newTape.resize(1000, 1000);
+  reorder.record(newTape);
+
+  typename T::Index wIndex = reorder.translateIndex(w.getGradientData());
+  newTape.setGradient(wIndex, 1.0);
+  newTape.evaluate();
+
+  std::vector<double> gradient(3);
+  for(size_t i = 0; i < gradient.size(); ++i) {
+    typename T::GradientValue adjoint = newTape.getGradient(reorder.translateIndex(x[i].getGradientData()));
+    gradient[i] = codi::TypeTraits<typename T::Real>::getBaseValue(firstDirection(adjoint));
+  }
+
+  return gradient;
+}
+
+template<typename T>
+std::vector<double> evaluateEliminated(T& tape, const typename T::Position& start, const typename T::Position& end,
+                                       NUMBER* x, NUMBER& w, bool& eliminated, std::false_type) {
+  eliminated = true;
+
+  return evaluateTape(tape, start, end, x, w);
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  Tape& tape = NUMBER::getGlobalTape();
+
+  NUMBER w;
+  Tape::Position start = tape.getPosition();
+  recordFunction(x, w);
+  Tape::Position end = tape.getPosition();
+
+  bool eliminated = false;
+  std::vector<double> gradient = evaluateEliminated(tape, start, end, x, w, eliminated, IsLinearJacobiTape());
+  printGradient(gradient);
+  std::cout << "Matches tape evaluation: " << isEqual(gradient, evaluateTape(tape, start, end, x, w)) << std::endl;
+  std::cout << "Chains eliminated: " << eliminated << std::endl;
+
+  y[0] = w;
+}
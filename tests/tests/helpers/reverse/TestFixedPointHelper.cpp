@@ -0,0 +1,206 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#include <toolDefines.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+IN(2)
+OUT(1)
+POINTS(2) = {{1.0, 0.5}, {-0.5, 1.5}};
+
+typedef NUMBER::TapeType Tape;
+
+/*
+ * The helper is compared with the tape evaluation of all iterations. Both are converged to the same fixed point.
+ */
+
+template<typename T>
+const T& firstDirection(const T& value) {
+  return value;
+}
+
+template<typename T, size_t n>
+const T& firstDirection(const codi::Direction<T, n>& value) {
+  return value[0];
+}
+
+/*
+ * Tapes which reset the primal values need to evaluate on the primal value vector for the evaluation by positions.
+ */
+template<typename T>
+auto setUsePrimalCopy(T& tape, bool useCopy, int) -> decltype(tape.setUsePrimalCopy(useCopy)) {
+  tape.setUsePrimalCopy(useCopy);
+}
+
+template<typename T>
+void setUsePrimalCopy(T& tape, bool useCopy, long) {
+  CODI_UNUSED(tape);
+  CODI_UNUSED(useCopy);
+}
+
+const size_t FullIterations = 200;
+
+/*
+ * Scalar fixed point iteration.
+ */
+void iterateScalar(NUMBER* state, NUMBER* p) {
+  state[0] = 0.5 * p[0] * cos(state[0]) + p[1];
+}
+
+/*
+ * Fixed point iteration with two coupled state entries.
+ */
+void iterateVector(NUMBER* state, NUMBER* p) {
+  NUMBER s0 = state[0];
+  state[0] = 0.3 * sin(state[1]) + p[0];
+  state[1] = 0.4 * p[1] * cos(s0) + 0.1 * state[1];
+}
+
+NUMBER computeOutput(NUMBER* state, size_t size) {
+  NUMBER w = state[0] * state[0];
+  for(size_t i = 1; i < size; ++i) {
+    w += state[0] * state[i];
+  }
+
+  return w;
+}
+
+std::vector<double> getGradient(Tape& tape, NUMBER* x) {
+  std::vector<double> gradient(2);
+  for(size_t i = 0; i < gradient.size(); ++i) {
+    gradient[i] = codi::TypeTraits<Tape::Real>::getBaseValue(firstDirection(x[i].getGradient()));
+  }
+  tape.clearAdjoints();
+
+  return gradient;
+}
+
+NUMBER recordFullIteration(NUMBER* x, size_t size, void (*iterate)(NUMBER*, NUMBER*)) {
+  std::vector<NUMBER> state(size);
+  for(size_t iter = 0; iter < FullIterations; ++iter) {
+    iterate(state.data(), x);
+  }
+
+  return computeOutput(state.data(), size);
+}
+
+std::vector<double> evaluateFullTape(NUMBER* x, size_t size, void (*iterate)(NUMBER*, NUMBER*)) {
+  Tape& tape = NUMBER::getGlobalTape();
+
+  Tape::Position start = tape.getPosition();
+  NUMBER w = recordFullIteration(x, size, iterate);
+  Tape::Position end = tape.getPosition();
+
+  w.setGradient(1.0);
+  tape.evaluate(end, start);
+
+  return getGradient(tape, x);
+}
+
+std::vector<double> evaluateHelper(NUMBER* x, size_t size, void (*iterate)(NUMBER*, NUMBER*), size_t maxIterations,
+                                   size_t& adjointIterations) {
+  Tape& tape = NUMBER::getGlobalTape();
+
+  Tape::Position start = tape.getPosition();
+  std::vector<NUMBER> state(size);
+
+  tape.setPassive();
+  for(size_t iter = 0; iter < FullIterations; ++iter) {
+    iterate(state.data(), x);
+  }
+  tape.setActive();
+
+  codi::FixedPointHelper<NUMBER> fp;
+  fp.setMaxIterations(maxIterations);
+  fp.start(state.data(), size);
+  iterate(state.data(), x);
+  fp.finish(state.data(), size);
+
+  NUMBER w = computeOutput(state.data(), size);
+  Tape::Position end = tape.getPosition();
+
+  w.setGradient(1.0);
+  tape.evaluate(end, fp.getEndPosition());
+  adjointIterations = fp.evaluate();
+  tape.evaluate(fp.getStartPosition(), start);
+
+  return getGradient(tape, x);
+}
+
+bool isEqual(const std::vector<double>& a, const std::vector<double>& b) {
+  bool equal = a.size() == b.size();
+  for(size_t i = 0; equal && i < a.size(); ++i) {
+    equal = std::abs(a[i] - b[i]) <= 1e-10 * std::max(1.0, std::abs(b[i]));
+  }
+
+  return equal;
+}
+
+void printGradient(const std::vector<double>& gradient) {
+  std::cout << "Gradient:";
+  for(double value : gradient) {
+    std::cout << " " << value;
+  }
+  std::cout << std::endl;
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  Tape& tape = NUMBER::getGlobalTape();
+  setUsePrimalCopy(tape, false, 0);
+
+  Tape::Position start = tape.getPosition();
+  size_t adjointIterations;
+
+  std::vector<double> fullScalar = evaluateFullTape(x, 1, iterateScalar);
+  std::vector<double> helperScalar = evaluateHelper(x, 1, iterateScalar, 1000, adjointIterations);
+  std::cout << "Scalar state" << std::endl;
+  printGradient(fullScalar);
+  std::cout << "Matches full tape: " << isEqual(helperScalar, fullScalar) << std::endl;
+  std::cout << "Converged before the limit: " << (adjointIterations < 1000) << std::endl;
+
+  std::vector<double> fullVector = evaluateFullTape(x, 2, iterateVector);
+  std::vector<double> helperVector = evaluateHelper(x, 2, iterateVector, 1000, adjointIterations);
+  std::cout << "Vector state" << std::endl;
+  printGradient(fullVector);
+  std::cout << "Matches full tape: " << isEqual(helperVector, fullVector) << std::endl;
+  std::cout << "Converged before the limit: " << (adjointIterations < 1000) << std::endl;
+
+  // The adjoint iteration stops after three evaluations and is not converged.
+  std::vector<double> limitedVector = evaluateHelper(x, 2, iterateVector, 3, adjointIterations);
+  std::cout << "Limited iterations: " << adjointIterations << std::endl;
+  std::cout << "Limited result differs: " << !isEqual(limitedVector, fullVector) << std::endl;
+
+  setUsePrimalCopy(tape, true, 0);
+
+  // The evaluations above have changed the primal values of the recorded statements, the output is recorded again.
+  tape.reset(start);
+  y[0] = recordFullIteration(x, 1, iterateScalar) + recordFullIteration(x, 2, iterateVector);
+}
@@ -0,0 +1,57 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+#include <iostream>
+
+IN(6)
+OUT(4)
+POINTS(2) = {{0.5, 2.0, -1.5, 3.0, 1.25, -0.75},
+             {2.0, -1.0, 0.5, 4.0, -2.0, 1.5}};
+
+void func(NUMBER* x, NUMBER* y) {
+  typedef codi::LinearAlgebraHelper<NUMBER> LA;
+
+  NUMBER A[4] = {x[0], x[1], x[2], x[3]};
+  NUMBER v[2] = {x[4], x[5]};
+
+  NUMBER w[2];
+  NUMBER C[4];
+  NUMBER s[2];
+
+  LA::gemv(2, 2, A, v, w);
+  LA::axpy(2, x[0], v, w);
+  LA::gemm(2, 2, 2, A, A, C);
+  LA::solve(2, C, w, s);
+  LA::dot(2, s, v, y[0]);
+
+  y[1] = s[0];
+  y[2] = C[3];
+  y[3] = w[1];
+}
@@ -0,0 +1,117 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2018 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+#include <iostream>
+#include <vector>
+
+IN(5)
+OUT(4)
+POINTS(2) = {{0.5, -1.0, 1.0, 2.0, 3.0},
+             {1.5, 0.75, -2.0, 0.5, 1.0}};
+
+typedef NUMBER::Real Real;
+
+const size_t N = 3;
+const size_t NNZ = 7;
+const int ROWS[NNZ] = {0, 0, 1, 1, 1, 2, 2};
+const int COLS[NNZ] = {0, 1, 0, 1, 2, 1, 2};
+
+void jacobiSolve(size_t n, size_t nnz, const int* rows, const int* cols, const Real* values, const Real* rhs, Real* sol) {
+  std::vector<Real> diag(n);
+  std::vector<Real> next(n);
+
+  for(size_t k = 0; k < nnz; ++k) {
+    if(rows[k] == cols[k]) {
+      diag[rows[k]] = values[k];
+    }
+  }
+
+  for(size_t i = 0; i < n; ++i) {
+    sol[i] = 0.0;
+  }
+
+  for(int iter = 0; iter < 100; ++iter) {
+    for(size_t i = 0; i < n; ++i) {
+      next[i] = rhs[i];
+    }
+    for(size_t k = 0; k < nnz; ++k) {
+      if(rows[k] != cols[k]) {
+        next[rows[k]] -= values[k] * sol[cols[k]];
+      }
+    }
+    for(size_t i = 0; i < n; ++i) {
+      sol[i] = next[i] / diag[i];
+    }
+  }
+}
+
+void solve(size_t n, size_t nnz, const int* rows, const int* cols, const Real* values, const Real* rhs, Real* sol, codi::DataStore* d) {
+  CODI_UNUSED(d);
+
+  jacobiSolve(n, nnz, rows, cols, values, rhs, sol);
+}
+
+void solveTransposed(size_t n, size_t nnz, const int* rows, const int* cols, const Real* values, const Real* rhs, Real* sol, codi::DataStore* d) {
+  CODI_UNUSED(d);
+
+  jacobiSolve(n, nnz, cols, rows, values, rhs, sol);
+}
+
+void solveStore(size_t n, size_t nnz, const int* rows, const int* cols, const Real* values, const Real* rhs, Real* sol, codi::DataStore* d) {
+  jacobiSolve(n, nnz, rows, cols, values, rhs, sol);
+
+  d->addData(std::vector<Real>(values, values + nnz));
+}
+
+void solveTransposedStore(size_t n, size_t nnz, const int* rows, const int* cols, const Real* values, const Real* rhs, Real* sol, codi::DataStore* d) {
+  CODI_UNUSED(values);
+
+  const std::vector<Real>& storedValues = d->getData<std::vector<Real> >();
+
+  jacobiSolve(n, nnz, cols, rows, storedValues.data(), rhs, sol);
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  NUMBER values[NNZ] = {4.0 + x[0], x[1], x[0] * x[1], 5.0, x[1], 1.0, 3.0 - x[0]};
+
+  NUMBER sol1[N];
+  codi::LinearSolverHelper<NUMBER> lh(solve, solveTransposed);
+  lh.solve(N, NNZ, ROWS, COLS, values, &x[2], sol1);
+
+  NUMBER sol2[N];
+  codi::LinearSolverHelper<NUMBER> lhStore(solveStore, solveTransposedStore);
+  lhStore.disableMatrixStore();
+  lhStore.solve(N, NNZ, ROWS, COLS, values, sol1, sol2);
+
+  y[0] = sol1[0];
+  y[1] = sol1[2];
+  y[2] = sol2[1];
+  y[3] = sol2[0] * sol2[2];
+}
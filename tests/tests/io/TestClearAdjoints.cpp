@@ -0,0 +1,53 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#include <toolDefines.h>
+
+IN(2)
+OUT(2)
+POINTS(2) = {{1.0, 2.0}, {0.5, -1.5}};
+
+void func(NUMBER* x, NUMBER* y) {
+  NUMBER::TapeType& tape = NUMBER::getGlobalTape();
+
+  NUMBER t = x[0] * x[1];
+  NUMBER::TapeType::Position start = tape.getPosition();
+  NUMBER w = sin(t) + x[0] * t;
+  NUMBER::TapeType::Position end = tape.getPosition();
+
+  // The partial sweeps write adjoints outside of the evaluated range, clearAdjoints has to reset them.
+  w.setGradient(1.0);
+  tape.evaluate(end, start);
+  tape.clearAdjoints();
+
+  t.setGradient(1.0);
+  tape.evaluateForward(start, end);
+  tape.clearAdjoints();
+
+  y[0] = w;
+  y[1] = t * w;
+}
@@ -0,0 +1,72 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+#include <iostream>
+
+IN(2)
+OUT(1)
+POINTS(2) = {{1.0, 2.0}, {0.5, -1.5}};
+
+static void emptyFunc(void* tape, void* data, void* adjointInterface) {
+  CODI_UNUSED(tape);
+  CODI_UNUSED(data);
+  CODI_UNUSED(adjointInterface);
+}
+
+static void emptyDelete(void* tape, void* data) {
+  CODI_UNUSED(tape);
+  CODI_UNUSED(data);
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  NUMBER::TapeType& tape = NUMBER::getGlobalTape();
+  NUMBER::TapeType otherTape;
+
+  tape.resetInstrumentation();
+
+  NUMBER::TapeType::Position start = tape.getPosition();
+  NUMBER t = x[0] * x[1];
+  tape.pushExternalFunctionHandle(&emptyFunc, NULL, &emptyDelete);
+  NUMBER w = sin(t);
+  NUMBER::TapeType::Position end = tape.getPosition();
+
+  w.setGradient(1.0);
+  tape.evaluate(end, start);
+  tape.clearAdjoints();
+
+  // The counters are gathered per tape.
+  codi::Instrumentation counters = tape.getInstrumentation();
+  codi::Instrumentation otherCounters = otherTape.getInstrumentation();
+  std::cout << "External function calls: " << counters.externalFunctionCalls << std::endl;
+  std::cout << "Evaluate time measured: " << (counters.evaluateTime > 0) << std::endl;
+  std::cout << "Other tape: " << otherCounters.externalFunctionCalls << " " << otherCounters.evaluateTime << std::endl;
+
+  y[0] = w + t;
+}
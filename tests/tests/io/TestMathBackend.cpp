@@ -0,0 +1,84 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#include <cmath>
+
+/* A math backend as it would be provided by the user, the kernels forward to the standard library. */
+struct TestMathBackend {
+    template<typename Real>
+    static void sincos(const Real& a, Real& sineValue, Real& cosineValue) {
+      using std::sin;
+      using std::cos;
+
+      sineValue = sin(a);
+      cosineValue = cos(a);
+    }
+
+    template<typename Real>
+    static void sinhcosh(const Real& a, Real& sinhValue, Real& coshValue) {
+      using std::sinh;
+      using std::cosh;
+
+      sinhValue = sinh(a);
+      coshValue = cosh(a);
+    }
+};
+
+#define CODI_MathBackend TestMathBackend
+
+#include <toolDefines.h>
+
+IN(2)
+OUT(2)
+POINTS(2) = {{1.0, 2.0}, {0.5, -1.5}};
+
+template<typename T>
+const T& firstDirection(const T& value) {
+  return value;
+}
+
+template<typename T, size_t n>
+const T& firstDirection(const codi::Direction<T, n>& value) {
+  return value[0];
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  NUMBER::TapeType& tape = NUMBER::getGlobalTape();
+
+  NUMBER::TapeType::Position start = tape.getPosition();
+  NUMBER u = sin(x[0]) * cos(x[1]) + sinh(x[0]) * cosh(x[1]);
+  NUMBER::TapeType::Position end = tape.getPosition();
+
+  // The forward evaluation of the primal value tapes uses the kernels of the backend.
+  x[1].setGradient(1.0);
+  tape.evaluateForward(start, end);
+  double tangent = codi::TypeTraits<NUMBER::Real>::getBaseValue(firstDirection(u.getGradient()));
+  tape.clearAdjoints();
+
+  y[0] = u;
+  y[1] = x[1] * tangent;
+}
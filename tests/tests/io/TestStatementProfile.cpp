@@ -0,0 +1,123 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+IN(2)
+OUT(1)
+POINTS(2) = {{1.0, 2.0}, {-0.5, 0.25}};
+
+typedef NUMBER::TapeType Tape;
+
+/*
+ * Only the primal value tapes provide a statement profile. The check is true for all other tapes.
+ */
+template<typename T>
+auto resetProfile(T& tape, int) -> decltype(T::getStatementProfile(), void()) {
+  CODI_UNUSED(tape);
+  T::getStatementProfile().reset();
+}
+
+template<typename T>
+void resetProfile(T& tape, long) {
+  CODI_UNUSED(tape);
+}
+
+template<typename T>
+auto checkProfile(T& tape, size_t evaluations, size_t expressions, int) -> decltype(T::getStatementProfile(), bool()) {
+  CODI_UNUSED(tape);
+
+  typedef typename std::remove_reference<decltype(T::getStatementProfile())>::type Profile;
+  std::vector<typename Profile::Entry> entries = T::getStatementProfile().getEntries();
+
+  bool correct = entries.size() == expressions;
+  size_t count = 0;
+  for(size_t i = 0; i < entries.size(); ++i) {
+    count += entries[i].count;
+    correct &= std::string::npos != entries[i].name.find("codi::");
+    if(0 != i) {
+      correct &= entries[i - 1].cycles >= entries[i].cycles;
+    }
+  }
+  correct &= count == evaluations;
+
+  std::stringstream table;
+  T::getStatementProfile().formatDefault(table);
+  std::string line;
+  size_t lines = 0;
+  while(std::getline(table, line)) {
+    lines += 1;
+  }
+  correct &= lines == expressions + 1;
+
+  return correct;
+}
+
+template<typename T>
+bool checkProfile(T& tape, size_t evaluations, size_t expressions, long) {
+  CODI_UNUSED(tape);
+  CODI_UNUSED(evaluations);
+  CODI_UNUSED(expressions);
+
+  return true;
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  Tape& tape = NUMBER::getGlobalTape();
+
+  resetProfile(tape, 0);
+
+  // Four statements with three different expressions.
+  Tape::Position start = tape.getPosition();
+  NUMBER a = x[0] * x[1];
+  NUMBER b = sin(x[0]);
+  NUMBER c = a * x[1];
+  NUMBER w = b + c;
+  Tape::Position end = tape.getPosition();
+
+  w.setGradient(1.0);
+  tape.evaluate(end, start);
+  tape.clearAdjoints();
+
+  std::cout << "Profile consistent: " << checkProfile(tape, 4, 3, 0) << std::endl;
+
+  // A second sweep over the same statements doubles the counts.
+  w.setGradient(1.0);
+  tape.evaluate(end, start);
+  tape.clearAdjoints();
+
+  std::cout << "Profile consistent after second sweep: " << checkProfile(tape, 8, 3, 0) << std::endl;
+
+  y[0] = w;
+}
@@ -0,0 +1,169 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+IN(3)
+OUT(1)
+POINTS(2) = {{1.0, 2.0, 3.0}, {-0.5, 0.25, 4.0}};
+
+typedef NUMBER::TapeType Tape;
+typedef codi::TapeGraph<Tape> Graph;
+
+size_t countLines(const std::string& text, const std::string& pattern) {
+  size_t count = 0;
+  std::istringstream in(text);
+  std::string line;
+  while(std::getline(in, line)) {
+    if(std::string::npos != line.find(pattern)) {
+      count += 1;
+    }
+  }
+
+  return count;
+}
+
+double getSum(const std::vector<Tape::Real>& values, size_t start, size_t end) {
+  double sum = 0.0;
+  for(size_t i = start; i < end; ++i) {
+    sum += codi::TypeTraits<Tape::Real>::getBaseValue(values[i]);
+  }
+
+  return sum;
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  Tape& tape = NUMBER::getGlobalTape();
+
+  Tape::Position start = tape.getPosition();
+  NUMBER a = x[0] * x[1];
+  NUMBER b = sin(x[0]);
+  NUMBER c = a + b;
+  NUMBER d = c * x[2];
+  NUMBER e = exp(b) / a;
+  y[0] = d + e;
+  Tape::Position end = tape.getPosition();
+
+  // The structure of the graph does not depend on the tape, the arguments of a statement are sorted since the
+  // Jacobi tapes may combine and reorder them.
+  Graph graph(tape, start, end);
+  std::cout << "Statements: " << graph.getStatementCount() << ", arguments: " << graph.getArgumentCount() << std::endl;
+  for(size_t stmt = 0; stmt < graph.getStatementCount(); ++stmt) {
+    std::vector<std::string> sources;
+    for(size_t arg = graph.argumentOffsets[stmt]; arg < graph.argumentOffsets[stmt + 1]; ++arg) {
+      if(Graph::InputArgument == graph.argumentStatements[arg]) {
+        sources.push_back("input");
+      } else {
+        sources.push_back("s" + std::to_string(graph.argumentStatements[arg]));
+      }
+    }
+    std::sort(sources.begin(), sources.end());
+
+    std::cout << "  s" << stmt << ":";
+    for(const std::string& source : sources) {
+      std::cout << " " << source;
+    }
+    std::cout << std::endl;
+  }
+
+  // Jacobi tapes provide the Jacobians, they are checked by the sum for each statement.
+  bool jacobiesCorrect = true;
+  if(!graph.jacobies.empty()) {
+    double x0 = codi::TypeTraits<NUMBER>::getBaseValue(x[0]);
+    double x1 = codi::TypeTraits<NUMBER>::getBaseValue(x[1]);
+    double x2 = codi::TypeTraits<NUMBER>::getBaseValue(x[2]);
+    double av = x0 * x1;
+    double bv = std::sin(x0);
+    double cv = av + bv;
+    double expected[6] = {x1 + x0, std::cos(x0), 2.0, x2 + cv, std::exp(bv) / av - std::exp(bv) / (av * av), 2.0};
+    for(size_t stmt = 0; stmt < graph.getStatementCount(); ++stmt) {
+      double sum = getSum(graph.jacobies, graph.argumentOffsets[stmt], graph.argumentOffsets[stmt + 1]);
+      jacobiesCorrect &= std::abs(sum - expected[stmt]) < 1e-12;
+    }
+  }
+  std::cout << "Jacobians correct: " << jacobiesCorrect << std::endl;
+
+  std::stringstream dot;
+  graph.writeDot(dot);
+  std::cout << "DOT: " << countLines(dot.str(), "shape=ellipse") << " inputs, " << countLines(dot.str(), "shape=box")
+            << " statements, " << countLines(dot.str(), "->") << " edges" << std::endl;
+
+  std::stringstream graphML;
+  graph.writeGraphML(graphML);
+  std::cout << "GraphML: " << countLines(graphML.str(), "<data key=\"kind\">input</data>") << " inputs, "
+            << countLines(graphML.str(), "<data key=\"kind\">statement</data>") << " statements, "
+            << countLines(graphML.str(), "<edge ") << " edges" << std::endl;
+
+  // The driver binaries of a test run in parallel, the process id makes the file name unique.
+  std::string filename = "graph_" + std::to_string(getpid()) + ".bin";
+  graph.writeBinary(filename);
+  {
+    codi::CoDiIoHandle handle(filename, false);
+    char magic[9] = {};
+    uint32_t header[5];
+    uint64_t sizes[2];
+    handle.readData(magic, 8);
+    handle.readData(header, 5);
+    handle.readData(sizes, 2);
+
+    std::vector<Tape::Index> lhsIndices(sizes[0]);
+    std::vector<uint64_t> offsets(sizes[0] + 1);
+    handle.readData(lhsIndices.data(), lhsIndices.size());
+    handle.readData(offsets.data(), offsets.size());
+
+    std::cout << "Binary: " << magic << " version " << header[0] << ", " << sizes[0] << " statements, " << sizes[1]
+              << " arguments, last offset " << offsets.back() << std::endl;
+  }
+  std::remove(filename.c_str());
+
+  codi::TapeLevelAnalysis<Tape> analysis(graph);
+  std::cout << "Levels:";
+  for(size_t level : analysis.levels) {
+    std::cout << " " << level;
+  }
+  std::cout << std::endl;
+  std::cout << "Critical path length: " << analysis.criticalPathLength << ", arguments: "
+            << analysis.criticalPathArguments << std::endl;
+  std::cout << "Maximum width: " << analysis.getMaximumWidth() << ", average width: " << analysis.getAverageWidth()
+            << std::endl;
+
+  codi::TapeValues values("Graph");
+  analysis.addValues(values);
+  values.formatCsvHeader(std::cout);
+  values.formatCsvRow(std::cout);
+}
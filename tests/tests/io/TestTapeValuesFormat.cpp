@@ -0,0 +1,82 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+#include <iostream>
+#include <limits>
+#include <string>
+
+IN(1)
+OUT(1)
+POINTS(1) = {{2.0}};
+
+codi::TapeValues createValues(double value, const std::string& sectionName) {
+  codi::TapeValues values("Test \"values\"");
+
+  values.addSection(sectionName);
+  values.addData("Count", (size_t)42);
+  values.addData("Memory", value, true, true);
+
+  values.addSection("Special, values; \\ \"quoted\"");
+  values.addData("Not a number", std::numeric_limits<double>::quiet_NaN());
+  values.addData("Infinity", std::numeric_limits<double>::infinity());
+  values.addData("Negative infinity", -std::numeric_limits<double>::infinity());
+
+  return values;
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  codi::TapeValues values = createValues(0.1, "Control\tcharacters\r\x01\x1f");
+
+  std::cout << "JSON:" << std::endl;
+  values.formatJson(std::cout);
+  std::cout << std::endl;
+
+  values = createValues(0.1, "Line\nbreak");
+  std::cout << "CSV:" << std::endl;
+  values.formatCsvHeader(std::cout);
+  values.formatCsvRow(std::cout);
+  values.formatCsvHeader(std::cout, ";");
+  values.formatCsvRow(std::cout, ";");
+
+  codi::TapeValuesRecorder recorder;
+  recorder.recordValues(createValues(1.0, "Line\nbreak"), "step \"1\"");
+  recorder.recordValues(createValues(2.5, "Line\nbreak"), "step\n2");
+
+  std::cout << "Recorder snapshots: " << recorder.getSnapshotCount() << std::endl;
+  std::cout << "Recorder CSV:" << std::endl;
+  recorder.writeCsv(std::cout);
+  std::cout << "Recorder JSON:" << std::endl;
+  recorder.writeJson(std::cout);
+
+  recorder.clear();
+  std::cout << "Recorder snapshots after clear: " << recorder.getSnapshotCount() << std::endl;
+
+  y[0] = x[0] * x[0];
+}
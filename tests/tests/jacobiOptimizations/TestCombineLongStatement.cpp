@@ -0,0 +1,96 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#include <toolDefines.h>
+
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+IN(1)
+OUT(1)
+POINTS(2) =
+{
+  {  1.0},
+  { -0.5}
+};
+
+/*
+ * Statements with more than JacobianSorter::HashThreshold distinct arguments use the hash table of the sorter.
+ */
+
+typedef codi::JacobianSorter<double, int> Sorter;
+
+struct StoredData {
+    std::vector<std::pair<int, double> > entries;
+
+    void setDataAndMove(const double& jacobi, const int& index) {
+      entries.push_back(std::make_pair(index, jacobi));
+    }
+};
+
+bool checkSorter(Sorter& sorter, int offset, int distinct, int repetitions) {
+  std::map<int, double> expected;
+  for(int rep = 0; rep < repetitions; ++rep) {
+    for(int i = 0; i < distinct; ++i) {
+      int index = offset + i * 7;
+      double jacobi = 1.0 + i + 0.5 * rep;
+      sorter.setDataAndMove(jacobi, index);
+      expected[index] += jacobi;
+    }
+  }
+
+  StoredData data;
+  sorter.storeData(data);
+
+  bool correct = data.entries.size() == expected.size();
+  for(size_t pos = 0; pos < data.entries.size(); ++pos) {
+    correct &= 1 == expected.count(data.entries[pos].first);
+    correct &= expected[data.entries[pos].first] == data.entries[pos].second;
+  }
+
+  return correct;
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  Sorter sorter;
+  std::cout << "Linear search: " << checkSorter(sorter, 1, Sorter::HashThreshold - 2, 3) << std::endl;
+  std::cout << "Hash table: " << checkSorter(sorter, 1, 3 * Sorter::HashThreshold, 2) << std::endl;
+  std::cout << "Hash table after reset: " << checkSorter(sorter, 5, 2 * Sorter::HashThreshold + 1, 3) << std::endl;
+  std::cout << "Linear search after reset: " << checkSorter(sorter, 5, Sorter::HashThreshold - 1, 2) << std::endl;
+
+  NUMBER t[20];
+  for(int i = 0; i < 20; ++i) {
+    t[i] = x[0] * (1.0 + 0.25 * i);
+  }
+
+  // 20 distinct arguments and 6 of them a second time
+  y[0] = t[0] * t[1] + t[2] * t[3] + t[4] * t[5] + t[6] * t[7] + t[8] * t[9]
+       + t[10] * t[11] + t[12] * t[13] + t[14] * t[15] + t[16] * t[17] + t[18] * t[19]
+       + t[0] * t[19] + t[5] * t[7] + t[11] * t[13];
+}
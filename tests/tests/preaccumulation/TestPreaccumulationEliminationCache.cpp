@@ -0,0 +1,97 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+#include <toolDefines.h>
+
+#include <iostream>
+
+IN(2)
+OUT(2)
+POINTS(1) = {
+  {  1.0,     0.5}
+};
+
+void evalFuncA(NUMBER* x, NUMBER* y) {
+  y[0] = x[0];
+  y[1] = x[1];
+  for(int i = 0; i < 3; ++i) {
+    NUMBER xTemp = y[0];
+    NUMBER yTemp = y[1];
+
+    y[0] = xTemp * xTemp - yTemp * yTemp - 0.65;
+    y[1] = 2.0 * yTemp * xTemp;
+  }
+}
+
+void evalFuncB(NUMBER* x, NUMBER* y) {
+  y[0] = sin(x[0]) * x[1];
+  y[1] = x[0] + x[1] * x[1];
+}
+
+void func(NUMBER* x, NUMBER* y) {
+
+#ifdef REVERSE_TAPE
+  codi::PreaccumulationHelper<NUMBER> ph;
+  ph.setMethod(codi::PreaccumulationMethod::VertexElimination);
+  ph.setPatternKey(0);
+#else
+  codi::ForwardPreaccumulationHelper<NUMBER> ph;
+#endif
+
+  // The region with the other structure replaces the compiled elimination, the sequence has two cache hits.
+  const bool useA[5] = {true, true, false, true, true};
+
+  y[0] = 0.0;
+  y[1] = 0.0;
+  for(int i = 0; i < 5; ++i) {
+    NUMBER scaledX[2] = {x[0] * (0.5 + 0.125 * i), x[1] * (0.5 + 0.125 * i)};
+    NUMBER scaledY[2];
+
+    ph.start(scaledX[0], scaledX[1]);
+
+    if(useA[i]) {
+      evalFuncA(scaledX, scaledY);
+    } else {
+      evalFuncB(scaledX, scaledY);
+    }
+
+    ph.finish(false, scaledY[0], scaledY[1]);
+
+    y[0] += scaledY[0];
+    y[1] += scaledY[1];
+  }
+
+#ifdef REVERSE_TAPE
+  // the compiled elimination is only cached for Jacobi tapes with a linear index handler
+  typedef NUMBER::TapeType Tape;
+  bool isCached = Tape::AllowJacobiOptimization && Tape::LinearIndexHandler;
+  size_t expectedHits = isCached ? 2 : 0;
+  size_t expectedMisses = isCached ? 3 : 0;
+  std::cout << "Cache hits as expected: " << (expectedHits == ph.getEliminationCacheHits()) << std::endl;
+  std::cout << "Cache misses as expected: " << (expectedMisses == ph.getEliminationCacheMisses()) << std::endl;
+#endif
+}
@@ -0,0 +1,77 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2019 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring, (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+IN(2)
+OUT(2)
+POINTS(2) = {
+  {  2.0,     3.0},
+  { -1.0,     0.5}
+};
+
+#ifdef REVERSE_TAPE
+void evalRegions(codi::PreaccumulationMethod method, NUMBER* x, NUMBER* y) {
+  codi::PreaccumulationHelper<NUMBER> ph;
+  ph.setMethod(method);
+  ph.setPatternKey(7);
+#else
+void evalRegions(NUMBER* x, NUMBER* y) {
+  codi::ForwardPreaccumulationHelper<NUMBER> ph;
+#endif
+
+  // The same key is used for regions where the second input is either x[1] or an alias of x[0].
+  for(int i = 0; i < 4; ++i) {
+    NUMBER& second = (1 == i % 2) ? x[0] : x[1];
+
+    ph.start(x[0], second);
+
+    NUMBER t0 = x[0] * second;
+    NUMBER t1 = sin(x[0]) + 2.0 * second;
+
+    ph.finish(false, t0, t1);
+
+    y[0] += t0;
+    y[1] += t1;
+  }
+}
+
+void func(NUMBER* x, NUMBER* y) {
+  y[0] = 0.0;
+  y[1] = 0.0;
+
+#ifdef REVERSE_TAPE
+  evalRegions(codi::PreaccumulationMethod::Sweeps, x, y);
+  evalRegions(codi::PreaccumulationMethod::LocalWorkspace, x, y);
+  evalRegions(codi::PreaccumulationMethod::VertexElimination, x, y);
+#else
+  evalRegions(x, y);
+  evalRegions(x, y);
+  evalRegions(x, y);
+#endif
+}